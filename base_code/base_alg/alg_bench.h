@@ -0,0 +1,168 @@
+#ifndef _MY_BENCH_H__
+#define _MY_BENCH_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <random>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * 基准测试工具
+ * 1、Zipfian分布key生成(YCSB)
+ * 2、采样式延迟统计，输出分位数
+ * 3、常驻内存(RSS)读取
+ * 4、LLC缺失计数(perf_event_open)，内核不允许时返回-1
+ */
+namespace my_bench {
+// Zipfian分布，theta越大热点越集中，返回[0, n)
+class ZipfGenerator {
+public:
+    ZipfGenerator(uint64_t n, double theta, uint64_t seed)
+        : items{n}
+        , theta{theta}
+        , rng{seed} {
+        zetan = zeta(n, theta);
+        double zeta2 = zeta(2, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    uint64_t next() {
+        double u = dist(rng);
+        double uz = u * zetan;
+        if (uz < 1.0)
+            return 0;
+        if (uz < 1.0 + std::pow(0.5, theta))
+            return 1;
+        return (uint64_t)(items * std::pow(eta * u - eta + 1, alpha)) % items;
+    }
+
+private:
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; i++) {
+            sum += 1.0 / std::pow((double)i, theta);
+        }
+        return sum;
+    }
+
+    uint64_t items;
+    double theta;
+    double zetan;
+    double alpha;
+    double eta;
+    std::mt19937_64 rng;
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+};
+
+// 延迟统计: 每SAMPLE_EVERY次操作计时一次，降低计时本身的开销
+class LatencySampler {
+public:
+    static constexpr long SAMPLE_EVERY = 16;
+
+    template <typename Func>
+    void run(long i, Func &&fn) {
+        if (i % SAMPLE_EVERY != 0) {
+            fn();
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void merge(const LatencySampler &other) {
+        samples.insert(samples.end(), other.samples.begin(), other.samples.end());
+    }
+
+    // p取0~100，无样本返回0
+    double percentile(double p) {
+        if (samples.empty())
+            return 0;
+        size_t idx = std::min(samples.size() - 1, (size_t)(p / 100.0 * samples.size()));
+        std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+        return samples[idx];
+    }
+
+    void clear() {
+        samples.clear();
+    }
+
+private:
+    std::vector<double> samples;
+};
+
+// 当前进程常驻内存字节数，读取失败返回0
+inline size_t rss_bytes() {
+    FILE *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+    long pages = 0, resident = 0;
+    int ret = std::fscanf(file, "%ld %ld", &pages, &resident);
+    std::fclose(file);
+    if (ret != 2)
+        return 0;
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// LLC缺失计数，覆盖调用线程及start之后创建的子线程
+class LlcCounter {
+public:
+    LlcCounter() {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    ~LlcCounter() {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    LlcCounter(const LlcCounter &) = delete;
+    LlcCounter &operator=(const LlcCounter &) = delete;
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void start() {
+        if (fd < 0)
+            return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    // 返回start以来的缺失次数，不可用返回-1
+    long stop() {
+        if (fd < 0)
+            return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count))
+            return -1;
+        return (long)count;
+    }
+
+private:
+    int fd;
+};
+
+} // namespace my_bench
+
+#endif
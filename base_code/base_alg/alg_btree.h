@@ -0,0 +1,535 @@
+#ifndef _MY_BTREE_H__
+#define _MY_BTREE_H__
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * B+树，有序集合，接口与AVLTree对应
+ * 1、节点大小按缓存行整数倍设计(默认256字节)，每层一次访存可比较几十个key
+ * 2、节点内查找为计数式线性扫描，int32 key 用SSE2一次比较4个
+ * 3、叶子节点串成链表，区间扫描只需顺序访问叶子
+ * 4、支持从有序序列批量构建
+ */
+namespace my_tree {
+
+namespace btree_detail {
+// 统计 keys[0..n) 中小于x的个数
+template <typename T>
+inline int count_lt(const T *keys, int n, const T &x) {
+    int cnt = 0;
+    for (int i = 0; i < n; i++) {
+        cnt += keys[i] < x;
+    }
+    return cnt;
+}
+
+// 统计 keys[0..n) 中小于等于x的个数
+template <typename T>
+inline int count_le(const T *keys, int n, const T &x) {
+    int cnt = 0;
+    for (int i = 0; i < n; i++) {
+        cnt += !(x < keys[i]);
+    }
+    return cnt;
+}
+
+#if defined(__SSE2__)
+inline int count_lt(const int32_t *keys, int n, const int32_t &x) {
+    __m128i vx = _mm_set1_epi32(x);
+    int cnt = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i vk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        cnt += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(vk, vx))));
+    }
+    for (; i < n; i++) {
+        cnt += keys[i] < x;
+    }
+    return cnt;
+}
+
+inline int count_le(const int32_t *keys, int n, const int32_t &x) {
+    __m128i vx = _mm_set1_epi32(x);
+    int cnt = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i vk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        cnt += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(vk, vx))));
+    }
+    for (; i < n; i++) {
+        cnt += keys[i] <= x;
+    }
+    return cnt;
+}
+#endif
+} // namespace btree_detail
+
+template <typename T, int NODE_BYTES = 256>
+class BPlusTree {
+public:
+    // 每个节点容量由节点字节数推算
+    static constexpr int LEAF_CAP = (NODE_BYTES - 16) / (int)sizeof(T) > 4 ? (NODE_BYTES - 16) / (int)sizeof(T) : 4;
+    static constexpr int INNER_CAP = (NODE_BYTES - 16) / (int)(sizeof(T) + sizeof(void *)) > 4
+                                         ? (NODE_BYTES - 16) / (int)(sizeof(T) + sizeof(void *))
+                                         : 4;
+    static constexpr int LEAF_MIN = LEAF_CAP / 2;
+    static constexpr int INNER_MIN = INNER_CAP / 2;
+
+    BPlusTree()
+        : root{new Leaf()}
+        , tree_height{1}
+        , node_cnt{0} {}
+
+    ~BPlusTree() {
+        free_node(root, tree_height);
+    }
+
+    BPlusTree(const BPlusTree &) = delete;
+    BPlusTree &operator=(const BPlusTree &) = delete;
+
+    // 插入节点，已存在返回false
+    bool insert_node(const T &value) {
+        PathEntry path[MAX_HEIGHT];
+        Leaf *leaf = find_leaf(value, path);
+        int pos = btree_detail::count_lt(leaf->keys, leaf->count, value);
+        if (pos < leaf->count && !(value < leaf->keys[pos])) {
+            return false;
+        }
+        node_cnt++;
+        if (leaf->count < LEAF_CAP) {
+            insert_at(leaf->keys, leaf->count, pos, value);
+            leaf->count++;
+            return true;
+        }
+
+        // 叶子已满，分裂后把分隔key插入父节点
+        T temp[LEAF_CAP + 1];
+        for (int i = 0; i < pos; i++) {
+            temp[i] = leaf->keys[i];
+        }
+        temp[pos] = value;
+        for (int i = pos; i < LEAF_CAP; i++) {
+            temp[i + 1] = leaf->keys[i];
+        }
+        Leaf *right = new Leaf();
+        int left_cnt = (LEAF_CAP + 1) / 2;
+        for (int i = 0; i < left_cnt; i++) {
+            leaf->keys[i] = temp[i];
+        }
+        for (int i = left_cnt; i < LEAF_CAP + 1; i++) {
+            right->keys[i - left_cnt] = temp[i];
+        }
+        leaf->count = left_cnt;
+        right->count = LEAF_CAP + 1 - left_cnt;
+        right->next = leaf->next;
+        leaf->next = right;
+        insert_parent(path, tree_height - 2, right->keys[0], right);
+        return true;
+    }
+
+    // 删除节点，不存在返回false
+    bool delete_node(const T &value) {
+        PathEntry path[MAX_HEIGHT];
+        Leaf *leaf = find_leaf(value, path);
+        int pos = btree_detail::count_lt(leaf->keys, leaf->count, value);
+        if (pos >= leaf->count || value < leaf->keys[pos]) {
+            return false;
+        }
+        node_cnt--;
+        erase_at(leaf->keys, leaf->count, pos);
+        leaf->count--;
+
+        // 自底向上处理下溢: 先向兄弟借，借不到则合并
+        void *node = leaf;
+        for (int level = tree_height - 2; level >= 0; level--) {
+            Inner *parent = path[level].node;
+            int ci = path[level].idx;
+            bool is_leaf = level == tree_height - 2;
+            if (is_leaf ? static_cast<Leaf *>(node)->count >= LEAF_MIN
+                        : static_cast<Inner *>(node)->count >= INNER_MIN) {
+                break;
+            }
+            if (is_leaf) {
+                fix_leaf(parent, ci);
+            } else {
+                fix_inner(parent, ci);
+            }
+            node = parent;
+        }
+
+        // 根节点没有key时降低一层
+        if (tree_height > 1 && static_cast<Inner *>(root)->count == 0) {
+            Inner *old_root = static_cast<Inner *>(root);
+            root = old_root->children[0];
+            delete old_root;
+            tree_height--;
+        }
+        return true;
+    }
+
+    // 查找节点
+    bool find_node(const T &value) const {
+        const void *node = root;
+        for (int level = 0; level < tree_height - 1; level++) {
+            const Inner *inner = static_cast<const Inner *>(node);
+            node = inner->children[btree_detail::count_le(inner->keys, inner->count, value)];
+        }
+        const Leaf *leaf = static_cast<const Leaf *>(node);
+        int pos = btree_detail::count_lt(leaf->keys, leaf->count, value);
+        return pos < leaf->count && !(value < leaf->keys[pos]);
+    }
+
+    // 中序遍历，fn(const T&)
+    template <typename Func>
+    void for_each_inorder(Func &&fn) const {
+        for (const Leaf *leaf = first_leaf(); leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                fn(leaf->keys[i]);
+            }
+        }
+    }
+
+    // 区间[lo, hi]扫描，fn(const T&)，返回个数
+    template <typename Func>
+    size_t for_each_range(const T &lo, const T &hi, Func &&fn) const {
+        size_t cnt = 0;
+        const void *node = root;
+        for (int level = 0; level < tree_height - 1; level++) {
+            const Inner *inner = static_cast<const Inner *>(node);
+            node = inner->children[btree_detail::count_le(inner->keys, inner->count, lo)];
+        }
+        const Leaf *leaf = static_cast<const Leaf *>(node);
+        int pos = btree_detail::count_lt(leaf->keys, leaf->count, lo);
+        for (; leaf; leaf = leaf->next, pos = 0) {
+            if (leaf->next) {
+                __builtin_prefetch(leaf->next);
+            }
+            for (; pos < leaf->count; pos++) {
+                if (hi < leaf->keys[pos]) {
+                    return cnt;
+                }
+                fn(leaf->keys[pos]);
+                cnt++;
+            }
+        }
+        return cnt;
+    }
+
+    // 中序遍历B+树
+    void inorder_traversal() const {
+        for_each_inorder([](const T &data) { std::cout << data << " "; });
+    }
+
+    // 从严格递增序列批量构建，O(n)，原有内容清空
+    // fill为叶子填充率，留出空位可减少后续插入的分裂
+    template <typename Iter>
+    void bulk_load(Iter first, Iter last, double fill = 1.0) {
+        clear();
+        std::vector<T> values(first, last);
+        if (values.empty()) {
+            return;
+        }
+        int per_leaf = (int)(LEAF_CAP * fill);
+        per_leaf = per_leaf < LEAF_MIN ? LEAF_MIN : (per_leaf > LEAF_CAP ? LEAF_CAP : per_leaf);
+
+        // 叶子层，最后两个叶子均分以满足最小占用
+        std::vector<void *> level_nodes;
+        std::vector<T> level_keys; // 每个节点的最小key
+        size_t n = values.size();
+        std::vector<size_t> sizes = split_sizes(n, per_leaf, LEAF_MIN, LEAF_CAP);
+        Leaf *prev = nullptr;
+        size_t offset = 0;
+        for (size_t cnt : sizes) {
+            Leaf *leaf = new Leaf();
+            for (size_t i = 0; i < cnt; i++) {
+                leaf->keys[i] = values[offset + i];
+            }
+            leaf->count = (int)cnt;
+            if (prev) {
+                prev->next = leaf;
+            }
+            prev = leaf;
+            level_nodes.push_back(leaf);
+            level_keys.push_back(values[offset]);
+            offset += cnt;
+        }
+        delete static_cast<Leaf *>(root);
+        tree_height = 1;
+
+        // 逐层向上构建内部节点
+        while (level_nodes.size() > 1) {
+            std::vector<void *> upper_nodes;
+            std::vector<T> upper_keys;
+            std::vector<size_t> fanouts = split_sizes(level_nodes.size(), INNER_CAP + 1, INNER_MIN + 1, INNER_CAP + 1);
+            offset = 0;
+            for (size_t fanout : fanouts) {
+                Inner *inner = new Inner();
+                inner->children[0] = level_nodes[offset];
+                for (size_t i = 1; i < fanout; i++) {
+                    inner->keys[i - 1] = level_keys[offset + i];
+                    inner->children[i] = level_nodes[offset + i];
+                }
+                inner->count = (int)fanout - 1;
+                upper_nodes.push_back(inner);
+                upper_keys.push_back(level_keys[offset]);
+                offset += fanout;
+            }
+            level_nodes.swap(upper_nodes);
+            level_keys.swap(upper_keys);
+            tree_height++;
+        }
+        root = level_nodes[0];
+        node_cnt = n;
+    }
+
+    // 清空
+    void clear() {
+        free_node(root, tree_height);
+        root = new Leaf();
+        tree_height = 1;
+        node_cnt = 0;
+    }
+
+    size_t size() const {
+        return node_cnt;
+    }
+
+    int height() const {
+        return tree_height;
+    }
+
+private:
+    static constexpr int MAX_HEIGHT = 32;
+
+    struct Leaf {
+        int count = 0;
+        Leaf *next = nullptr; // 右兄弟叶子
+        T keys[LEAF_CAP];
+    };
+
+    struct Inner {
+        int count = 0; // key个数，子节点数为count+1
+        T keys[INNER_CAP];
+        void *children[INNER_CAP + 1];
+    };
+
+    struct PathEntry {
+        Inner *node;
+        int idx; // 走向的子节点下标
+    };
+
+    // 查找所在叶子，记录路径
+    Leaf *find_leaf(const T &value, PathEntry *path) const {
+        void *node = root;
+        for (int level = 0; level < tree_height - 1; level++) {
+            Inner *inner = static_cast<Inner *>(node);
+            int idx = btree_detail::count_le(inner->keys, inner->count, value);
+            path[level] = {inner, idx};
+            node = inner->children[idx];
+        }
+        return static_cast<Leaf *>(node);
+    }
+
+    const Leaf *first_leaf() const {
+        const void *node = root;
+        for (int level = 0; level < tree_height - 1; level++) {
+            node = static_cast<const Inner *>(node)->children[0];
+        }
+        return static_cast<const Leaf *>(node);
+    }
+
+    // 向父节点插入分隔key与右子节点，父节点满时继续分裂
+    void insert_parent(PathEntry *path, int level, const T &key, void *right) {
+        if (level < 0) {
+            // 根节点分裂，树高加一
+            Inner *new_root = new Inner();
+            new_root->keys[0] = key;
+            new_root->children[0] = root;
+            new_root->children[1] = right;
+            new_root->count = 1;
+            root = new_root;
+            tree_height++;
+            return;
+        }
+        Inner *parent = path[level].node;
+        int pos = path[level].idx;
+        if (parent->count < INNER_CAP) {
+            insert_at(parent->keys, parent->count, pos, key);
+            insert_at(parent->children, parent->count + 1, pos + 1, right);
+            parent->count++;
+            return;
+        }
+
+        T temp_keys[INNER_CAP + 1];
+        void *temp_children[INNER_CAP + 2];
+        for (int i = 0; i < INNER_CAP; i++) {
+            temp_keys[i] = parent->keys[i];
+        }
+        for (int i = 0; i <= INNER_CAP; i++) {
+            temp_children[i] = parent->children[i];
+        }
+        insert_at(temp_keys, INNER_CAP, pos, key);
+        insert_at(temp_children, INNER_CAP + 1, pos + 1, right);
+
+        // 中间key上移，两侧各自成为节点
+        int mid = (INNER_CAP + 1) / 2;
+        Inner *sibling = new Inner();
+        parent->count = mid;
+        for (int i = 0; i < mid; i++) {
+            parent->keys[i] = temp_keys[i];
+            parent->children[i] = temp_children[i];
+        }
+        parent->children[mid] = temp_children[mid];
+        sibling->count = INNER_CAP - mid;
+        for (int i = 0; i < sibling->count; i++) {
+            sibling->keys[i] = temp_keys[mid + 1 + i];
+            sibling->children[i] = temp_children[mid + 1 + i];
+        }
+        sibling->children[sibling->count] = temp_children[INNER_CAP + 1];
+        insert_parent(path, level - 1, temp_keys[mid], sibling);
+    }
+
+    // 叶子下溢: 借用或合并
+    void fix_leaf(Inner *parent, int ci) {
+        Leaf *node = static_cast<Leaf *>(parent->children[ci]);
+        Leaf *left = ci > 0 ? static_cast<Leaf *>(parent->children[ci - 1]) : nullptr;
+        Leaf *right = ci < parent->count ? static_cast<Leaf *>(parent->children[ci + 1]) : nullptr;
+        if (left && left->count > LEAF_MIN) {
+            insert_at(node->keys, node->count, 0, left->keys[left->count - 1]);
+            node->count++;
+            left->count--;
+            parent->keys[ci - 1] = node->keys[0];
+        } else if (right && right->count > LEAF_MIN) {
+            node->keys[node->count++] = right->keys[0];
+            erase_at(right->keys, right->count, 0);
+            right->count--;
+            parent->keys[ci] = right->keys[0];
+        } else if (left) {
+            for (int i = 0; i < node->count; i++) {
+                left->keys[left->count + i] = node->keys[i];
+            }
+            left->count += node->count;
+            left->next = node->next;
+            delete node;
+            erase_at(parent->keys, parent->count, ci - 1);
+            erase_at(parent->children, parent->count + 1, ci);
+            parent->count--;
+        } else {
+            for (int i = 0; i < right->count; i++) {
+                node->keys[node->count + i] = right->keys[i];
+            }
+            node->count += right->count;
+            node->next = right->next;
+            delete right;
+            erase_at(parent->keys, parent->count, ci);
+            erase_at(parent->children, parent->count + 1, ci + 1);
+            parent->count--;
+        }
+    }
+
+    // 内部节点下溢: 经父节点分隔key借用或合并
+    void fix_inner(Inner *parent, int ci) {
+        Inner *node = static_cast<Inner *>(parent->children[ci]);
+        Inner *left = ci > 0 ? static_cast<Inner *>(parent->children[ci - 1]) : nullptr;
+        Inner *right = ci < parent->count ? static_cast<Inner *>(parent->children[ci + 1]) : nullptr;
+        if (left && left->count > INNER_MIN) {
+            insert_at(node->keys, node->count, 0, parent->keys[ci - 1]);
+            insert_at(node->children, node->count + 1, 0, left->children[left->count]);
+            node->count++;
+            parent->keys[ci - 1] = left->keys[left->count - 1];
+            left->count--;
+        } else if (right && right->count > INNER_MIN) {
+            node->keys[node->count] = parent->keys[ci];
+            node->children[node->count + 1] = right->children[0];
+            node->count++;
+            parent->keys[ci] = right->keys[0];
+            erase_at(right->keys, right->count, 0);
+            erase_at(right->children, right->count + 1, 0);
+            right->count--;
+        } else {
+            if (left) {
+                // 统一为右侧并入左侧
+                right = node;
+                node = left;
+                ci--;
+            }
+            node->keys[node->count] = parent->keys[ci];
+            for (int i = 0; i < right->count; i++) {
+                node->keys[node->count + 1 + i] = right->keys[i];
+            }
+            for (int i = 0; i <= right->count; i++) {
+                node->children[node->count + 1 + i] = right->children[i];
+            }
+            node->count += right->count + 1;
+            delete right;
+            erase_at(parent->keys, parent->count, ci);
+            erase_at(parent->children, parent->count + 1, ci + 1);
+            parent->count--;
+        }
+    }
+
+    // n个元素按每组per个划分，最后一组不足min时并入前一组，超出cap则两组均分
+    static std::vector<size_t> split_sizes(size_t n, size_t per, size_t min, size_t cap) {
+        std::vector<size_t> sizes;
+        while (n > 0) {
+            size_t cnt = n < per ? n : per;
+            sizes.push_back(cnt);
+            n -= cnt;
+        }
+        if (sizes.size() > 1 && sizes.back() < min) {
+            size_t total = sizes[sizes.size() - 2] + sizes.back();
+            sizes.pop_back();
+            if (total <= cap) {
+                sizes.back() = total;
+            } else {
+                sizes.back() = total - total / 2;
+                sizes.push_back(total / 2);
+            }
+        }
+        return sizes;
+    }
+
+    template <typename U>
+    static void insert_at(U *array, int n, int pos, const U &value) {
+        for (int i = n; i > pos; i--) {
+            array[i] = array[i - 1];
+        }
+        array[pos] = value;
+    }
+
+    template <typename U>
+    static void erase_at(U *array, int n, int pos) {
+        for (int i = pos; i < n - 1; i++) {
+            array[i] = array[i + 1];
+        }
+    }
+
+    void free_node(void *node, int height) {
+        if (height == 1) {
+            delete static_cast<Leaf *>(node);
+            return;
+        }
+        Inner *inner = static_cast<Inner *>(node);
+        for (int i = 0; i <= inner->count; i++) {
+            free_node(inner->children[i], height - 1);
+        }
+        delete inner;
+    }
+
+private:
+    void *root;
+    int tree_height; // 1表示根为叶子
+    size_t node_cnt;
+};
+
+} // namespace my_tree
+
+#endif
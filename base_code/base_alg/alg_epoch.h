@@ -0,0 +1,169 @@
+#ifndef _MY_EPOCH_H__
+#define _MY_EPOCH_H__
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 基于纪元(epoch)的内存回收
+ * 1、读者进入临界区时在槽位中登记当前纪元，退出时清零，不加锁
+ * 2、写者摘除节点后调用retire，记录摘除时的纪元
+ * 3、所有活跃读者的纪元都大于节点的摘除纪元时，节点不可能再被访问，可以释放
+ */
+namespace my_epoch {
+
+class EpochDomain {
+public:
+    static constexpr int SLOT_NUM = 128; // 最大并发读者数
+
+    EpochDomain()
+        : global_epoch{1} {
+        for (auto &slot : slots) {
+            slot.epoch.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~EpochDomain() {
+        // 析构时不应再有读者
+        for (auto &r : retired) {
+            r.deleter(r.ptr);
+        }
+        retired.clear();
+    }
+
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    // 进入读临界区，返回占用的槽位
+    int enter() {
+        static std::atomic<unsigned> thread_cnt{0};
+        thread_local unsigned hint = thread_cnt.fetch_add(1, std::memory_order_relaxed);
+        unsigned idx = hint % SLOT_NUM;
+        while (true) {
+            uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+            uint64_t expect = 0;
+            if (slots[idx].epoch.compare_exchange_strong(expect, epoch, std::memory_order_seq_cst)) {
+                // 登记后纪元可能已推进，登记旧值只会让回收更保守
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return idx;
+            }
+            idx = (idx + 1) % SLOT_NUM;
+            if (idx == hint % SLOT_NUM) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // 退出读临界区
+    void leave(int idx) {
+        slots[idx].epoch.store(0, std::memory_order_release);
+    }
+
+    // 延迟释放已摘除的对象
+    template <typename U>
+    void retire(U *ptr) {
+        retire(ptr, [](void *p) { delete static_cast<U *>(p); });
+    }
+
+    // 延迟释放，使用自定义释放函数(如非new分配的对象)
+    void retire(void *ptr, void (*deleter)(void *)) {
+        std::unique_lock<std::mutex> lock(retire_mtx);
+        uint64_t epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst);
+        retired.push_back({ptr, deleter, epoch});
+        if (retired.size() >= RECLAIM_THRESHOLD) {
+            reclaim_locked();
+        }
+    }
+
+    // 尝试回收
+    void reclaim() {
+        std::unique_lock<std::mutex> lock(retire_mtx);
+        reclaim_locked();
+    }
+
+    // 待回收数量
+    size_t retired_size() {
+        std::unique_lock<std::mutex> lock(retire_mtx);
+        return retired.size();
+    }
+
+private:
+    static constexpr size_t RECLAIM_THRESHOLD = 64;
+
+    struct Retired {
+        void *ptr;
+        void (*deleter)(void *);
+        uint64_t epoch; // 摘除时的纪元
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch; // 0 表示空闲
+    };
+
+    // 活跃读者中最小的纪元
+    uint64_t min_active_epoch() {
+        uint64_t min_epoch = UINT64_MAX;
+        for (auto &slot : slots) {
+            uint64_t e = slot.epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < min_epoch) {
+                min_epoch = e;
+            }
+        }
+        return min_epoch;
+    }
+
+    void reclaim_locked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t min_epoch = min_active_epoch();
+        size_t keep = 0;
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (retired[i].epoch < min_epoch) {
+                retired[i].deleter(retired[i].ptr);
+            } else {
+                retired[keep++] = retired[i];
+            }
+        }
+        retired.resize(keep);
+    }
+
+private:
+    std::atomic<uint64_t> global_epoch;
+    Slot slots[SLOT_NUM];
+    std::mutex retire_mtx;
+    std::vector<Retired> retired;
+};
+
+// 读临界区守卫，离开作用域自动退出
+class EpochGuard {
+public:
+    explicit EpochGuard(EpochDomain &d)
+        : domain{&d}
+        , slot{d.enter()} {}
+
+    ~EpochGuard() {
+        if (domain) {
+            domain->leave(slot);
+        }
+    }
+
+    EpochGuard(EpochGuard &&other) noexcept
+        : domain{other.domain}
+        , slot{other.slot} {
+        other.domain = nullptr;
+    }
+
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard &operator=(const EpochGuard &) = delete;
+    EpochGuard &operator=(EpochGuard &&) = delete;
+
+private:
+    EpochDomain *domain;
+    int slot;
+};
+
+} // namespace my_epoch
+
+#endif
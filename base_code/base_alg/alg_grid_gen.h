@@ -0,0 +1,123 @@
+#ifndef _MY_GRID_GEN_H__
+#define _MY_GRID_GEN_H__
+
+#include "alg_search.h"
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * 网格地图生成与导入，输出CostGrid(0为障碍，1为可通行)，同一种子结果相同
+ * 1、random_density: 每格独立按概率可通行
+ * 2、maze: 递归回溯迷宫(显式栈)，奇数坐标为房间格，通道宽1
+ * 3、rooms: 随机矩形房间，相邻房间用L形走廊连通
+ * 4、load_moving_ai: 读取Moving-AI基准的.map文件
+ */
+namespace my_search {
+inline CostGrid random_density(int rows, int cols, double density, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution open(density);
+    CostGrid grid(rows, cols, 0);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            grid.set(x, y, open(rng) ? 1 : 0);
+        }
+    }
+    return grid;
+}
+
+inline CostGrid maze(int rows, int cols, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    CostGrid grid(rows, cols, 0);
+    int cell_rows = (rows - 1) / 2, cell_cols = (cols - 1) / 2;
+    if (cell_rows <= 0 || cell_cols <= 0)
+        return grid;
+    std::vector<Point> stack{{0, 0}};
+    grid.set(1, 1, 1);
+    static const int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    while (!stack.empty()) {
+        Point cur = stack.back();
+        int options[4], cnt = 0;
+        for (int d = 0; d < 4; d++) {
+            int x = cur.first + dirs[d][0], y = cur.second + dirs[d][1];
+            if (x >= 0 && x < cell_rows && y >= 0 && y < cell_cols && !grid.passable(x * 2 + 1, y * 2 + 1))
+                options[cnt++] = d;
+        }
+        if (cnt == 0) {
+            stack.pop_back();
+            continue;
+        }
+        int d = options[rng() % cnt];
+        int x = cur.first + dirs[d][0], y = cur.second + dirs[d][1];
+        grid.set(cur.first * 2 + 1 + dirs[d][0], cur.second * 2 + 1 + dirs[d][1], 1); // 打通墙
+        grid.set(x * 2 + 1, y * 2 + 1, 1);
+        stack.push_back({x, y});
+    }
+    return grid;
+}
+
+inline CostGrid rooms(int rows, int cols, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    CostGrid grid(rows, cols, 0);
+    int max_side = std::max(4, std::min(rows, cols) / 16);
+    int room_cnt = std::max(2, (int)((long)rows * cols / ((long)max_side * max_side * 3)));
+    std::vector<Point> centers;
+    for (int i = 0; i < room_cnt; i++) {
+        int h = (int)(rng() % max_side) + 3, w = (int)(rng() % max_side) + 3;
+        int x0 = (int)(rng() % std::max(1, rows - h - 1)) + 1, y0 = (int)(rng() % std::max(1, cols - w - 1)) + 1;
+        for (int x = x0; x < std::min(rows - 1, x0 + h); x++) {
+            for (int y = y0; y < std::min(cols - 1, y0 + w); y++) {
+                grid.set(x, y, 1);
+            }
+        }
+        centers.push_back({std::min(rows - 1, x0 + h / 2), std::min(cols - 1, y0 + w / 2)});
+    }
+    // 按生成顺序两两连通: 先横向再纵向
+    for (size_t i = 1; i < centers.size(); i++) {
+        Point a = centers[i - 1], b = centers[i];
+        for (int y = std::min(a.second, b.second); y <= std::max(a.second, b.second); y++) {
+            grid.set(a.first, y, 1);
+        }
+        for (int x = std::min(a.first, b.first); x <= std::max(a.first, b.first); x++) {
+            grid.set(x, b.second, 1);
+        }
+    }
+    return grid;
+}
+
+// Moving-AI .map: "type octile / height H / width W / map"后接H行，'.' 'G' 'S'可通行
+inline bool load_moving_ai(const std::string &path, CostGrid &grid) {
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+    std::string line, word;
+    int height = -1, width = -1;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        in >> word;
+        if (word == "height")
+            in >> height;
+        else if (word == "width")
+            in >> width;
+        else if (word == "map")
+            break;
+    }
+    if (height <= 0 || width <= 0)
+        return false;
+    grid = CostGrid(height, width, 0);
+    for (int x = 0; x < height; x++) {
+        if (!std::getline(file, line) || (int)line.size() < width)
+            return false;
+        for (int y = 0; y < width; y++) {
+            char c = line[y];
+            grid.set(x, y, (c == '.' || c == 'G' || c == 'S') ? 1 : 0);
+        }
+    }
+    return true;
+}
+
+} // namespace my_search
+
+#endif
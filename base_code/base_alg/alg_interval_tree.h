@@ -0,0 +1,159 @@
+#ifndef _MY_INTERVAL_TREE_H__
+#define _MY_INTERVAL_TREE_H__
+
+#include "alg_tree.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * 区间树，闭区间[lo, hi]
+ * 1、基于AVLTree，按(lo, hi, value)排序，聚合值为子树内最大右端点，子树max < x时整棵剪枝
+ * 2、点查询(哪些区间包含x)、重叠查询(哪些区间与[a, b]相交)，耗时O(log n + k)
+ * 3、批量点查询先排序，多个查询共享一次树遍历
+ * 4、有序区间O(n)构建
+ */
+namespace my_tree {
+template <typename K, typename V = int>
+struct Interval {
+    K lo;
+    K hi;
+    V value; // 附带数据，参与排序以区分端点相同的区间
+
+    bool operator<(const Interval &other) const {
+        if (lo != other.lo)
+            return lo < other.lo;
+        if (hi != other.hi)
+            return hi < other.hi;
+        return value < other.value;
+    }
+    bool operator>(const Interval &other) const {
+        return other < *this;
+    }
+};
+
+// 最大右端点聚合
+template <typename K, typename V>
+struct IntervalMaxAug {
+    using value_type = K;
+    static value_type identity() { return std::numeric_limits<K>::lowest(); }
+    static value_type from(const Interval<K, V> &interval) { return interval.hi; }
+    static value_type combine(const value_type &a, const value_type &b) { return std::max(a, b); }
+};
+
+template <typename K, typename V = int>
+class IntervalTree {
+public:
+    using interval_type = Interval<K, V>;
+    using tree_type     = AVLTree<interval_type, IntervalMaxAug<K, V>>;
+    using node_type     = typename tree_type::node_type;
+
+    // 插入，区间已存在返回false
+    bool insert(const K &lo, const K &hi, const V &value = V{}) {
+        int old_size = tree.size();
+        tree.root = tree.insert_node(tree.root, interval_type{lo, hi, value});
+        return tree.size() != old_size;
+    }
+
+    // 删除，区间不存在返回false
+    bool remove(const K &lo, const K &hi, const V &value = V{}) {
+        int old_size = tree.size();
+        tree.root = tree.delete_node(tree.root, interval_type{lo, hi, value});
+        return tree.size() != old_size;
+    }
+
+    // 由按(lo, hi, value)有序且无重复的区间序列构建，替换原有内容
+    template <typename RandomIt>
+    void build_from_sorted(RandomIt first, RandomIt last) {
+        tree.build_from_sorted(first, last);
+    }
+
+    // 点查询: 对每个包含x的区间回调，返回个数
+    template <typename Func>
+    size_t stab(const K &x, Func &&fn) const {
+        return overlap(x, x, fn);
+    }
+
+    // 重叠查询: 对每个与[a, b]相交的区间按lo升序回调，返回个数
+    template <typename Func>
+    size_t overlap(const K &a, const K &b, Func &&fn) const {
+        size_t count = 0;
+        overlap(tree.root, a, b, fn, count);
+        return count;
+    }
+
+    // 批量点查询，out[i]为包含points[i]的区间
+    void stab_many(const std::vector<K> &points, std::vector<std::vector<interval_type>> &out) const {
+        out.assign(points.size(), {});
+        std::vector<size_t> order(points.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&points](size_t a, size_t b) { return points[a] < points[b]; });
+        stab_batch(tree.root, points, order.data(), order.data() + order.size(), out);
+    }
+
+    // 批量重叠查询，out[i]为与queries[i]相交的区间
+    void overlap_many(const std::vector<std::pair<K, K>> &queries,
+                      std::vector<std::vector<interval_type>> &out) const {
+        out.assign(queries.size(), {});
+        for (size_t i = 0; i < queries.size(); i++) {
+            std::vector<interval_type> &result = out[i];
+            overlap(queries[i].first, queries[i].second,
+                    [&result](const interval_type &interval) { result.push_back(interval); });
+        }
+    }
+
+    int size() const {
+        return tree.size();
+    }
+
+    int height() const {
+        return tree.get_height(tree.root);
+    }
+
+    void clear() {
+        tree.clear();
+    }
+
+private:
+    template <typename Func>
+    static void overlap(const node_type *node, const K &a, const K &b, Func &fn, size_t &count) {
+        // 子树最大右端点 < a 时无交集
+        while (node != nullptr && !(node->get_agg() < a)) {
+            overlap(node->left, a, b, fn, count);
+            // 右子树的lo都不小于当前lo
+            if (b < node->data.lo)
+                return;
+            if (!(node->data.hi < a)) {
+                fn(node->data);
+                count++;
+            }
+            node = node->right;
+        }
+    }
+
+    // order[first, last)为按坐标升序的查询下标，整批沿树下降
+    static void stab_batch(const node_type *node, const std::vector<K> &points, const size_t *first,
+                           const size_t *last, std::vector<std::vector<interval_type>> &out) {
+        while (node != nullptr && first != last) {
+            // 大于子树最大右端点的查询不会命中
+            last = std::upper_bound(first, last, node->get_agg(),
+                                    [&points](const K &value, size_t i) { return value < points[i]; });
+            stab_batch(node->left, points, first, last, out);
+            // 小于当前lo的查询不会命中当前节点及右子树
+            first = std::lower_bound(first, last, node->data.lo,
+                                     [&points](size_t i, const K &value) { return points[i] < value; });
+            for (const size_t *it = first; it != last && !(node->data.hi < points[*it]); ++it) {
+                out[*it].push_back(node->data);
+            }
+            node = node->right;
+        }
+    }
+
+    tree_type tree;
+};
+
+} // namespace my_tree
+
+#endif
@@ -1,12 +1,16 @@
 #ifndef _MY_LIST_H__
 #define _MY_LIST_H__
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "alg_epoch.h"
+
 /**
  * 链表存储 key+data
  */
@@ -53,69 +57,82 @@ public:
 
     // 添加
     int add_list(KEY_TYPE key, T data) {
-        int ret = false;
+        return emplace_list(key, std::move(data));
+    }
+
+    // 原地构造添加，参数直接转发给T的构造函数
+    template <typename... Args>
+    int emplace_list(KEY_TYPE key, Args &&...args) {
         std::unique_lock<std::mutex> lock(mtx);
         if (list_cur_size >= list_max_size) {
             print_tip("add_list failed list is full!");
-            return ret;
-        }
-
-        if (find_list(key) == nullptr) {
-            Node<T> *temp = new Node<T>;
-            temp->next = nullptr;
-            temp->prev = nullptr;
-            temp->key = key;
-            temp->data = std::move(data);
-            if (list_head == nullptr) {
-                list_head = temp;
-                list_tail = temp;
-            } else {
-                list_tail->next = temp;
-                temp->prev = list_tail;
-                list_tail = list_tail->next;
+            return false;
+        }
+        if (find_list(key) != nullptr) {
+            print_tip("add_list failed key is exist!:", key);
+            return false;
+        }
+        link_tail(new Node<T>{nullptr, nullptr, key, T(std::forward<Args>(args)...)});
+        return true;
+    }
+
+    // 批量添加，整批只加一次锁、只遍历一次链表，返回添加个数
+    int add_many(std::vector<std::pair<KEY_TYPE, T>> items) {
+        int cnt = 0;
+        std::unique_lock<std::mutex> lock(mtx);
+        std::unordered_set<KEY_TYPE> exist = collect_keys();
+        for (auto &item : items) {
+            if (list_cur_size >= list_max_size) {
+                print_tip("add_many failed list is full!");
+                break;
             }
-            list_cur_size++;
-            ret = true;
-        } else {
-            print_tip("add_list failed key is exist!:", key, data);
+            if (!exist.insert(item.first).second) {
+                print_tip("add_many failed key is exist!:", item.first);
+                continue;
+            }
+            link_tail(new Node<T>{nullptr, nullptr, item.first, std::move(item.second)});
+            cnt++;
         }
-        return ret;
+        return cnt;
     }
 
     // 删除元素
     int del_list(KEY_TYPE key) {
-        int ret = false;
         std::unique_lock<std::mutex> lock(mtx);
         Node<T> *temp = find_list(key);
-        if (temp != nullptr) {
-            if (temp->prev == nullptr) {
-                if (temp->next == nullptr) {
-                    list_head = nullptr;
-                    list_tail = nullptr;
-                } else {
-                    list_head = temp->next;
-                    list_head->prev = nullptr;
-                }
-            } else if (temp->next == nullptr) {
-                list_tail = temp->prev;
-                list_tail->next = nullptr;
-            } else {
-                temp->prev->next = temp->next;
-                temp->next->prev = temp->prev;
-            }
-            delete temp;
-            list_cur_size--;
-            ret = true;
-        } else {
+        if (temp == nullptr) {
             print_tip("key no exsit!:", key);
+            return false;
         }
-        return ret;
+        unlink(temp);
+        delete temp;
+        return true;
+    }
+
+    // 批量删除，整批只加一次锁、只遍历一次链表，返回删除个数
+    int del_many(const std::vector<KEY_TYPE> &keys) {
+        int cnt = 0;
+        std::unique_lock<std::mutex> lock(mtx);
+        std::unordered_set<KEY_TYPE> dels(keys.begin(), keys.end());
+        Node<T> *next = list_head;
+        while (next && cnt < (int)dels.size()) {
+            Node<T> *temp = next;
+            next = next->next;
+            prefetch(next);
+            if (dels.count(temp->key)) {
+                unlink(temp);
+                delete temp;
+                cnt++;
+            }
+        }
+        return cnt;
     }
 
     // 查找元素
     Node<T> *find_list(KEY_TYPE key) {
-        Node<T> *ret = nullptr, *next = list_head;
+        Node<T> *next = list_head;
         while (next) {
+            prefetch(next->next);
             if (next->key == key)
                 return next;
             next = next->next;
@@ -136,6 +153,46 @@ public:
         return false;
     }
 
+    // 批量查找，整批只加一次锁、只遍历一次链表，找到的元素按链表顺序追加到datas，返回找到个数
+    int find_many(const std::vector<KEY_TYPE> &keys, std::vector<std::pair<KEY_TYPE, T>> &datas) {
+        int cnt = 0;
+        std::unique_lock<std::mutex> lock(mtx);
+        std::unordered_set<KEY_TYPE> finds(keys.begin(), keys.end());
+        Node<T> *next = list_head;
+        while (next && cnt < (int)finds.size()) {
+            prefetch(next->next);
+            if (finds.count(next->key)) {
+                datas.emplace_back(next->key, next->data);
+                cnt++;
+            }
+            next = next->next;
+        }
+        return cnt;
+    }
+
+    // 在锁内对元素调用fn(T&)，不拷贝数据，返回是否找到
+    template <typename Func>
+    int with_value(KEY_TYPE key, Func &&fn) {
+        std::unique_lock<std::mutex> lock(mtx);
+        Node<T> *ret = find_list(key);
+        if (ret == nullptr) {
+            print_tip(" key is no exist!:", key);
+            return false;
+        }
+        std::forward<Func>(fn)(ret->data);
+        return true;
+    }
+
+    // 在锁内顺序遍历，fn(key, T&)
+    template <typename Func>
+    void for_each_list(Func &&fn) {
+        std::unique_lock<std::mutex> lock(mtx);
+        for (Node<T> *next = list_head; next; next = next->next) {
+            prefetch(next->next);
+            fn(next->key, next->data);
+        }
+    }
+
     // 获取大小
     int get_list_size() { 
         return list_cur_size; 
@@ -144,6 +201,52 @@ public:
     void print_list(std::string title);
 
 private:
+    // 预取下一个节点，遍历时隐藏指针追逐的访存延迟
+    static void prefetch(const Node<T> *node) {
+        if (node) {
+            __builtin_prefetch(node);
+        }
+    }
+
+    // 链接到尾部，需持有锁
+    void link_tail(Node<T> *temp) {
+        temp->prev = list_tail;
+        temp->next = nullptr;
+        if (list_head == nullptr) {
+            list_head = temp;
+        } else {
+            list_tail->next = temp;
+        }
+        list_tail = temp;
+        list_cur_size++;
+    }
+
+    // 从链表摘除，需持有锁
+    void unlink(Node<T> *temp) {
+        if (temp->prev == nullptr) {
+            list_head = temp->next;
+        } else {
+            temp->prev->next = temp->next;
+        }
+        if (temp->next == nullptr) {
+            list_tail = temp->prev;
+        } else {
+            temp->next->prev = temp->prev;
+        }
+        list_cur_size--;
+    }
+
+    // 收集已有键值，需持有锁
+    std::unordered_set<KEY_TYPE> collect_keys() {
+        std::unordered_set<KEY_TYPE> keys;
+        keys.reserve(list_cur_size);
+        for (Node<T> *next = list_head; next; next = next->next) {
+            prefetch(next->next);
+            keys.insert(next->key);
+        }
+        return keys;
+    }
+
     // 打印提示
     template <typename... Args> void print_tip(const Args &...args) {
         if (log_switch) {
@@ -174,6 +277,169 @@ void linked_list<T>::print_list(std::string title) {
     }
 }
 
+/**
+ * 读多写少的并发链表
+ * 1、读者不加锁遍历，find_list 不会被写者阻塞
+ * 2、写者之间用互斥锁串行，用原子指针摘链
+ * 3、被删除的节点交给纪元回收，确认没有读者持有后才释放
+ */
+template <typename T> 
+struct EpochNode {
+    std::atomic<EpochNode *> next; // 向后指针，读者可见
+    EpochNode *prev;               // 向前指针，仅写者使用
+    const KEY_TYPE key;            // 键值
+    const T data;                  // 数值，插入后不再修改
+
+    EpochNode(KEY_TYPE k, T &&d)
+        : next{nullptr}
+        , prev{nullptr}
+        , key{k}
+        , data{std::move(d)} {}
+};
+
+template <typename T> 
+class epoch_list {
+public:
+    explicit epoch_list(int max_size = 512, bool log = false)
+        : list_head{nullptr}
+        , list_tail{nullptr}
+        , list_cur_size{0} {
+        list_max_size = max_size;
+        log_switch = log;
+    }
+
+    ~epoch_list() { 
+        clear_list(); 
+    }
+
+    // 清空
+    int clear_list() {
+        std::unique_lock<std::mutex> lock(write_mtx);
+        EpochNode<T> *temp = list_head.exchange(nullptr, std::memory_order_acq_rel);
+        while (temp) {
+            EpochNode<T> *next = temp->next.load(std::memory_order_relaxed);
+            epoch.retire(temp);
+            temp = next;
+        }
+        list_tail = nullptr;
+        list_cur_size.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 添加
+    int add_list(KEY_TYPE key, T data) {
+        std::unique_lock<std::mutex> lock(write_mtx);
+        if (list_cur_size.load(std::memory_order_relaxed) >= list_max_size) {
+            print_tip("add_list failed list is full!");
+            return false;
+        }
+        if (find_node(key) != nullptr) {
+            print_tip("add_list failed key is exist!:", key);
+            return false;
+        }
+
+        // 节点完整构造后再发布，读者看到的一定是完整节点
+        EpochNode<T> *temp = new EpochNode<T>(key, std::move(data));
+        temp->prev = list_tail;
+        if (list_tail == nullptr) {
+            list_head.store(temp, std::memory_order_release);
+        } else {
+            list_tail->next.store(temp, std::memory_order_release);
+        }
+        list_tail = temp;
+        list_cur_size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 删除元素
+    int del_list(KEY_TYPE key) {
+        std::unique_lock<std::mutex> lock(write_mtx);
+        EpochNode<T> *temp = find_node(key);
+        if (temp == nullptr) {
+            print_tip("key no exsit!:", key);
+            return false;
+        }
+
+        // 只改前驱的next，被删节点的next保持不变，正在其上的读者仍能继续向后遍历
+        EpochNode<T> *next = temp->next.load(std::memory_order_relaxed);
+        if (temp->prev == nullptr) {
+            list_head.store(next, std::memory_order_release);
+        } else {
+            temp->prev->next.store(next, std::memory_order_release);
+        }
+        if (next == nullptr) {
+            list_tail = temp->prev;
+        } else {
+            next->prev = temp->prev;
+        }
+        list_cur_size.fetch_sub(1, std::memory_order_relaxed);
+        epoch.retire(temp);
+        return true;
+    }
+
+    // 查找元素并获取元素，不加锁
+    int find_list(KEY_TYPE key, T &data) {
+        my_epoch::EpochGuard guard(epoch);
+        EpochNode<T> *next = list_head.load(std::memory_order_acquire);
+        while (next) {
+            if (next->key == key) {
+                data = next->data;
+                return true;
+            }
+            next = next->next.load(std::memory_order_acquire);
+        }
+        print_tip(" key is no exist!:", key);
+        return false;
+    }
+
+    // 获取大小
+    int get_list_size() { 
+        return list_cur_size.load(std::memory_order_relaxed); 
+    }
+
+    void print_list(std::string title) {
+        my_epoch::EpochGuard guard(epoch);
+        std::cout << title << ":limit_size:" << list_max_size 
+                  << ","
+                  << "size:" << get_list_size() << std::endl;
+        EpochNode<T> *next = list_head.load(std::memory_order_acquire);
+        while (next) {
+            std::cout << "element:" << next->key << "," << next->data << std::endl;
+            next = next->next.load(std::memory_order_acquire);
+        }
+    }
+
+private:
+    // 写者查找，需持有write_mtx
+    EpochNode<T> *find_node(KEY_TYPE key) {
+        EpochNode<T> *next = list_head.load(std::memory_order_relaxed);
+        while (next) {
+            if (next->key == key)
+                return next;
+            next = next->next.load(std::memory_order_relaxed);
+        }
+        return nullptr;
+    }
+
+    // 打印提示
+    template <typename... Args> void print_tip(const Args &...args) {
+        if (log_switch) {
+            std::cout << "Info: ";
+            ((std::cout << args), ...);
+            std::cout << std::endl;
+        }
+    }
+
+private:
+    std::atomic<EpochNode<T> *> list_head;
+    EpochNode<T> *list_tail;
+    int list_max_size;
+    std::atomic<int> list_cur_size;
+    bool log_switch; // log 打印开关
+    std::mutex write_mtx;
+    my_epoch::EpochDomain epoch; // 析构时释放剩余节点
+};
+
 } // namespace my_list
 
 #endif
\ No newline at end of file
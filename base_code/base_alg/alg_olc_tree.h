@@ -0,0 +1,546 @@
+#ifndef _MY_OLC_TREE_H__
+#define _MY_OLC_TREE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * 并发有序索引，乐观锁耦合(Optimistic Lock Coupling)B+树
+ * 1、每个节点一个版本号: bit1 写锁，bit0 废弃，每次写解锁版本+4
+ * 2、读者不加锁，读节点前记下版本，读完校验版本未变，变了就从根重来
+ * 3、写者沿路径乐观下降，只对要修改的节点(及分裂时的父节点)升级为写锁
+ * 4、满节点在下降时提前分裂；删除不合并节点，节点只在析构时释放，读者无需内存回收
+ * 5、key与value须可平凡拷贝且std::atomic无锁，节点字段以relaxed原子读写，读者可能读到被并发修改的数据，校验失败后丢弃
+ */
+namespace my_tree {
+
+class OLCNode {
+public:
+    enum class Type : uint8_t { Inner, Leaf };
+
+    explicit OLCNode(Type t)
+        : type{t}
+        , version{0b100} {}
+
+    // 读加锁: 返回当前版本，被写锁住时需要重来
+    uint64_t read_lock_or_restart(bool &need_restart) const {
+        uint64_t v = version.load(std::memory_order_acquire);
+        if (is_locked(v) || is_obsolete(v)) {
+            pause();
+            need_restart = true;
+        }
+        return v;
+    }
+
+    // 校验读期间版本未变
+    void check_or_restart(uint64_t start, bool &need_restart) const {
+        read_unlock_or_restart(start, need_restart);
+    }
+
+    void read_unlock_or_restart(uint64_t start, bool &need_restart) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        need_restart = need_restart || (start != version.load(std::memory_order_relaxed));
+    }
+
+    // 从读版本升级为写锁，版本已变则失败
+    void upgrade_to_write_lock_or_restart(uint64_t &v, bool &need_restart) {
+        if (version.compare_exchange_strong(v, v + 0b10, std::memory_order_acquire)) {
+            v = v + 0b10;
+        } else {
+            pause();
+            need_restart = true;
+        }
+    }
+
+    void write_unlock() {
+        version.fetch_add(0b10, std::memory_order_release);
+    }
+
+    Type type;
+
+private:
+    static bool is_locked(uint64_t v) {
+        return (v & 0b10) == 0b10;
+    }
+    static bool is_obsolete(uint64_t v) {
+        return (v & 1) == 1;
+    }
+    static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    std::atomic<uint64_t> version;
+};
+
+template <typename K, typename V, int NODE_BYTES = 512>
+class OLCBTree {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "OLCBTree key/value must be trivially copyable");
+    static_assert(std::atomic<K>::is_always_lock_free && std::atomic<V>::is_always_lock_free,
+                  "OLCBTree key/value must be lock-free atomics");
+
+public:
+    static constexpr int LEAF_CAP = (NODE_BYTES - 32) / (int)(sizeof(K) + sizeof(V));
+    static constexpr int INNER_CAP = (NODE_BYTES - 32) / (int)(sizeof(K) + sizeof(void *));
+
+    OLCBTree()
+        : root{new Leaf()} {}
+
+    ~OLCBTree() {
+        free_node(root.load(std::memory_order_relaxed));
+    }
+
+    OLCBTree(const OLCBTree &) = delete;
+    OLCBTree &operator=(const OLCBTree &) = delete;
+
+    // 查找，读者不加锁
+    bool find(const K &key, V &value) const {
+        int restarts = 0;
+    restart:
+        backoff(restarts++);
+        bool need_restart = false;
+        OLCNode *node = root.load(std::memory_order_acquire);
+        uint64_t version = node->read_lock_or_restart(need_restart);
+        if (need_restart || node != root.load(std::memory_order_acquire))
+            goto restart;
+
+        Inner *parent = nullptr;
+        uint64_t parent_version = 0;
+        while (node->type == OLCNode::Type::Inner) {
+            Inner *inner = static_cast<Inner *>(node);
+            if (parent) {
+                parent->read_unlock_or_restart(parent_version, need_restart);
+                if (need_restart)
+                    goto restart;
+            }
+            parent = inner;
+            parent_version = version;
+            node = inner->child(inner->lower_bound(key));
+            // 子指针可能是并发修改中的值，校验后才能访问
+            inner->check_or_restart(version, need_restart);
+            if (need_restart)
+                goto restart;
+            version = node->read_lock_or_restart(need_restart);
+            if (need_restart)
+                goto restart;
+        }
+
+        Leaf *leaf = static_cast<Leaf *>(node);
+        int pos = leaf->lower_bound(key);
+        bool found = false;
+        V temp{};
+        if (pos < leaf->safe_count() && leaf->key(pos) == key) {
+            found = true;
+            temp = leaf->value(pos);
+        }
+        if (parent) {
+            parent->read_unlock_or_restart(parent_version, need_restart);
+            if (need_restart)
+                goto restart;
+        }
+        node->read_unlock_or_restart(version, need_restart);
+        if (need_restart)
+            goto restart;
+        if (found) {
+            value = temp;
+        }
+        return found;
+    }
+
+    // 插入或更新，新插入返回true
+    bool insert(const K &key, const V &value) {
+        int restarts = 0;
+    restart:
+        backoff(restarts++);
+        bool need_restart = false;
+        OLCNode *node = root.load(std::memory_order_acquire);
+        uint64_t version = node->read_lock_or_restart(need_restart);
+        if (need_restart || node != root.load(std::memory_order_acquire))
+            goto restart;
+
+        Inner *parent = nullptr;
+        uint64_t parent_version = 0;
+        while (node->type == OLCNode::Type::Inner) {
+            Inner *inner = static_cast<Inner *>(node);
+            // 满的内部节点提前分裂，保证父节点总能容纳分隔key
+            if (inner->safe_count() == INNER_CAP) {
+                if (!lock_for_split(parent, parent_version, node, version))
+                    goto restart;
+                K sep;
+                Inner *sibling = inner->split(sep);
+                link_split(parent, sep, inner, sibling);
+                node->write_unlock();
+                if (parent)
+                    parent->write_unlock();
+                goto restart;
+            }
+            if (parent) {
+                parent->read_unlock_or_restart(parent_version, need_restart);
+                if (need_restart)
+                    goto restart;
+            }
+            parent = inner;
+            parent_version = version;
+            node = inner->child(inner->lower_bound(key));
+            inner->check_or_restart(version, need_restart);
+            if (need_restart)
+                goto restart;
+            version = node->read_lock_or_restart(need_restart);
+            if (need_restart)
+                goto restart;
+        }
+
+        Leaf *leaf = static_cast<Leaf *>(node);
+        int pos = leaf->lower_bound(key);
+        bool exist = pos < leaf->safe_count() && leaf->key(pos) == key;
+        // 已存在只需原地更新，不必分裂；读到的内容由下面的升级写锁校验
+        if (leaf->safe_count() == LEAF_CAP && !exist) {
+            if (!lock_for_split(parent, parent_version, node, version))
+                goto restart;
+            K sep;
+            Leaf *sibling = leaf->split(sep);
+            link_split(parent, sep, leaf, sibling);
+            node->write_unlock();
+            if (parent)
+                parent->write_unlock();
+            goto restart;
+        }
+
+        // 只锁叶子
+        node->upgrade_to_write_lock_or_restart(version, need_restart);
+        if (need_restart)
+            goto restart;
+        if (parent) {
+            parent->read_unlock_or_restart(parent_version, need_restart);
+            if (need_restart) {
+                node->write_unlock();
+                goto restart;
+            }
+        }
+        bool inserted = leaf->insert(key, value);
+        node->write_unlock();
+        return inserted;
+    }
+
+    // 删除，不存在返回false；叶子可以变空，不做合并
+    bool remove(const K &key) {
+        int restarts = 0;
+    restart:
+        backoff(restarts++);
+        bool need_restart = false;
+        Leaf *leaf = nullptr;
+        uint64_t version = 0;
+        Inner *parent = nullptr;
+        uint64_t parent_version = 0;
+        if (!descend_to_leaf(key, leaf, version, parent, parent_version))
+            goto restart;
+
+        leaf->upgrade_to_write_lock_or_restart(version, need_restart);
+        if (need_restart)
+            goto restart;
+        if (parent) {
+            parent->read_unlock_or_restart(parent_version, need_restart);
+            if (need_restart) {
+                leaf->write_unlock();
+                goto restart;
+            }
+        }
+        bool removed = leaf->remove(key);
+        leaf->write_unlock();
+        return removed;
+    }
+
+    // 区间[lo, hi]扫描，追加到out，最多limit个，返回个数
+    size_t scan(const K &lo, const K &hi, std::vector<std::pair<K, V>> &out, size_t limit = SIZE_MAX) const {
+        size_t cnt = 0;
+        K from = lo;
+        bool exclusive = false; // 叶子重读时跳过已输出的key
+        std::pair<K, V> buffer[LEAF_CAP];
+        int restarts = 0;
+    restart:
+        backoff(restarts++);
+        Leaf *leaf = nullptr;
+        uint64_t version = 0;
+        Inner *parent = nullptr;
+        uint64_t parent_version = 0;
+        if (!descend_to_leaf(from, leaf, version, parent, parent_version))
+            goto restart;
+
+        while (leaf && cnt < limit) {
+            // 先复制到缓冲区，校验通过后再输出
+            bool need_restart = false;
+            int n = 0;
+            bool past_hi = false;
+            int count = leaf->safe_count();
+            for (int i = leaf->lower_bound(from); i < count && cnt + n < limit; i++) {
+                K key = leaf->key(i);
+                if (exclusive && !(from < key))
+                    continue;
+                if (hi < key) {
+                    past_hi = true;
+                    break;
+                }
+                buffer[n++] = {key, leaf->value(i)};
+            }
+            Leaf *next = leaf->next.load(std::memory_order_relaxed);
+            leaf->read_unlock_or_restart(version, need_restart);
+            if (need_restart)
+                goto restart;
+            for (int i = 0; i < n; i++) {
+                out.push_back(buffer[i]);
+            }
+            cnt += n;
+            if (n > 0) {
+                from = buffer[n - 1].first;
+                exclusive = true;
+            }
+            if (past_hi || next == nullptr)
+                break;
+            version = next->read_lock_or_restart(need_restart);
+            if (need_restart)
+                goto restart;
+            leaf = next;
+        }
+        return cnt;
+    }
+
+private:
+    // 乐观读取的字段均为atomic，读写一律relaxed，顺序由版本号的acquire/release保证
+    struct Inner : OLCNode {
+        std::atomic<int> count{0}; // key个数，子节点数为count+1
+        std::atomic<K> keys[INNER_CAP];
+        std::atomic<OLCNode *> children[INNER_CAP + 1];
+
+        Inner()
+            : OLCNode(Type::Inner) {}
+
+        int safe_count() const {
+            int c = count.load(std::memory_order_relaxed);
+            return c < 0 ? 0 : (c > INNER_CAP ? INNER_CAP : c);
+        }
+        K key(int i) const { return keys[i].load(std::memory_order_relaxed); }
+        void set_key(int i, const K &key) { keys[i].store(key, std::memory_order_relaxed); }
+        OLCNode *child(int i) const { return children[i].load(std::memory_order_relaxed); }
+        void set_child(int i, OLCNode *node) { children[i].store(node, std::memory_order_relaxed); }
+
+        // 第一个 >= key 的位置，子节点i存放 (keys[i-1], keys[i]] 的key
+        int lower_bound(const K &target) const {
+            int lo = 0, hi = safe_count();
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (key(mid) < target)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        // 中间key上移，右半部分移到新节点
+        Inner *split(K &sep) {
+            Inner *sibling = new Inner();
+            int n = safe_count();
+            int mid = n / 2;
+            sep = key(mid);
+            int right = n - mid - 1;
+            for (int i = 0; i < right; i++) {
+                sibling->set_key(i, key(mid + 1 + i));
+            }
+            for (int i = 0; i <= right; i++) {
+                sibling->set_child(i, child(mid + 1 + i));
+            }
+            sibling->count.store(right, std::memory_order_relaxed);
+            count.store(mid, std::memory_order_relaxed);
+            return sibling;
+        }
+
+        // 子节点left分裂出right，分隔key为left的最大key
+        void insert(const K &sep, OLCNode *right) {
+            int pos = lower_bound(sep);
+            int n = safe_count();
+            for (int i = n; i > pos; i--) {
+                set_key(i, key(i - 1));
+                set_child(i + 1, child(i));
+            }
+            set_key(pos, sep);
+            set_child(pos + 1, right);
+            count.store(n + 1, std::memory_order_relaxed);
+        }
+    };
+
+    struct Leaf : OLCNode {
+        std::atomic<int> count{0};
+        std::atomic<Leaf *> next{nullptr}; // 右兄弟，区间扫描使用
+        std::atomic<K> keys[LEAF_CAP];
+        std::atomic<V> values[LEAF_CAP];
+
+        Leaf()
+            : OLCNode(Type::Leaf) {}
+
+        int safe_count() const {
+            int c = count.load(std::memory_order_relaxed);
+            return c < 0 ? 0 : (c > LEAF_CAP ? LEAF_CAP : c);
+        }
+        K key(int i) const { return keys[i].load(std::memory_order_relaxed); }
+        V value(int i) const { return values[i].load(std::memory_order_relaxed); }
+        void set(int i, const K &key, const V &value) {
+            keys[i].store(key, std::memory_order_relaxed);
+            values[i].store(value, std::memory_order_relaxed);
+        }
+
+        int lower_bound(const K &target) const {
+            int lo = 0, hi = safe_count();
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (key(mid) < target)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        // 需持有写锁，已存在时更新值返回false
+        bool insert(const K &target, const V &value) {
+            int pos = lower_bound(target);
+            int n = safe_count();
+            if (pos < n && key(pos) == target) {
+                values[pos].store(value, std::memory_order_relaxed);
+                return false;
+            }
+            for (int i = n; i > pos; i--) {
+                set(i, key(i - 1), this->value(i - 1));
+            }
+            set(pos, target, value);
+            count.store(n + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool remove(const K &target) {
+            int pos = lower_bound(target);
+            int n = safe_count();
+            if (pos >= n || !(key(pos) == target)) {
+                return false;
+            }
+            for (int i = pos; i < n - 1; i++) {
+                set(i, key(i + 1), value(i + 1));
+            }
+            count.store(n - 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // 左半保留，右半移到新叶子，分隔key为左半最大key
+        Leaf *split(K &sep) {
+            Leaf *sibling = new Leaf();
+            int n = safe_count();
+            int half = n / 2;
+            for (int i = 0; i < n - half; i++) {
+                sibling->set(i, key(half + i), value(half + i));
+            }
+            sibling->count.store(n - half, std::memory_order_relaxed);
+            count.store(half, std::memory_order_relaxed);
+            sep = key(half - 1);
+            sibling->next.store(next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            next.store(sibling, std::memory_order_relaxed);
+            return sibling;
+        }
+    };
+
+    // 乐观下降到叶子，返回叶子版本与父节点版本(父节点仍处于读状态)
+    bool descend_to_leaf(const K &key, Leaf *&leaf, uint64_t &version, Inner *&parent,
+                         uint64_t &parent_version) const {
+        bool need_restart = false;
+        OLCNode *node = root.load(std::memory_order_acquire);
+        version = node->read_lock_or_restart(need_restart);
+        if (need_restart || node != root.load(std::memory_order_acquire))
+            return false;
+        parent = nullptr;
+        while (node->type == OLCNode::Type::Inner) {
+            Inner *inner = static_cast<Inner *>(node);
+            if (parent) {
+                parent->read_unlock_or_restart(parent_version, need_restart);
+                if (need_restart)
+                    return false;
+            }
+            parent = inner;
+            parent_version = version;
+            node = inner->child(inner->lower_bound(key));
+            inner->check_or_restart(version, need_restart);
+            if (need_restart)
+                return false;
+            version = node->read_lock_or_restart(need_restart);
+            if (need_restart)
+                return false;
+        }
+        leaf = static_cast<Leaf *>(node);
+        return true;
+    }
+
+    // 分裂前锁住父节点与当前节点
+    bool lock_for_split(Inner *parent, uint64_t &parent_version, OLCNode *node, uint64_t &version) {
+        bool need_restart = false;
+        if (parent) {
+            parent->upgrade_to_write_lock_or_restart(parent_version, need_restart);
+            if (need_restart)
+                return false;
+        }
+        node->upgrade_to_write_lock_or_restart(version, need_restart);
+        if (need_restart) {
+            if (parent)
+                parent->write_unlock();
+            return false;
+        }
+        // 没有父节点时当前节点必须仍是根
+        if (!parent && node != root.load(std::memory_order_acquire)) {
+            node->write_unlock();
+            return false;
+        }
+        return true;
+    }
+
+    void link_split(Inner *parent, const K &sep, OLCNode *left, OLCNode *right) {
+        if (parent) {
+            parent->insert(sep, right);
+        } else {
+            Inner *new_root = new Inner();
+            new_root->count.store(1, std::memory_order_relaxed);
+            new_root->set_key(0, sep);
+            new_root->set_child(0, left);
+            new_root->set_child(1, right);
+            root.store(new_root, std::memory_order_release);
+        }
+    }
+
+    static void backoff(int restarts) {
+        if (restarts > 16) {
+            std::this_thread::yield();
+        }
+    }
+
+    void free_node(OLCNode *node) {
+        if (node->type == OLCNode::Type::Inner) {
+            Inner *inner = static_cast<Inner *>(node);
+            for (int i = 0; i <= inner->safe_count(); i++) {
+                free_node(inner->child(i));
+            }
+            delete inner;
+        } else {
+            delete static_cast<Leaf *>(node);
+        }
+    }
+
+private:
+    std::atomic<OLCNode *> root;
+};
+
+} // namespace my_tree
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef _MY_PID_H__
+#define _MY_PID_H__
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * 批量PID控制器，T为float或double
+ * 1、增益、设定值、积分、上次误差按结构体数组(SoA)连续存放，一次update更新全部回路
+ * 2、每个回路独立的测量值与dt，由调用方以数组传入，热路径无I/O、无分配
+ * 3、按CPU能力选择内核: AVX-512 > AVX2 > 标量，函数级target属性编译，不要求全局-mavx；非x86只用标量内核
+ * 4、向量内核与标量内核的运算顺序相同且不用FMA，结果与逐个回路计算一致(编译器合并乘加时仅差末位舍入)
+ */
+namespace my_pid {
+enum class Isa { SCALAR, AVX2, AVX512 };
+
+inline const char *isa_name(Isa isa) {
+    switch (isa) {
+    case Isa::AVX512:
+        return "avx512";
+    case Isa::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+// 运行时检测CPU支持的最高指令集
+inline Isa detect_isa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return Isa::AVX2;
+#endif
+    return Isa::SCALAR;
+}
+
+// 各内核共用的参数: 全部指针指向长度为count的数组
+template <typename T>
+struct PIDArrays {
+    const T *kp;
+    const T *ki;
+    const T *kd;
+    const T *setpoint;
+    T *integral;
+    T *prev_error;
+    const T *measurement;
+    const T *dt;
+    T *output;
+};
+
+// 标量内核，也用于向量内核处理尾部
+template <typename T>
+inline void pid_scalar(const PIDArrays<T> &a, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        T error = a.setpoint[i] - a.measurement[i];
+        T integral = a.integral[i] + error * a.dt[i];
+        T derivative = (error - a.prev_error[i]) / a.dt[i];
+        a.output[i] = a.kp[i] * error + a.ki[i] * integral + a.kd[i] * derivative;
+        a.integral[i] = integral;
+        a.prev_error[i] = error;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) inline void pid_avx2(const PIDArrays<double> &a, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d error = _mm256_sub_pd(_mm256_loadu_pd(a.setpoint + i), _mm256_loadu_pd(a.measurement + i));
+        __m256d dt = _mm256_loadu_pd(a.dt + i);
+        __m256d integral = _mm256_add_pd(_mm256_loadu_pd(a.integral + i), _mm256_mul_pd(error, dt));
+        __m256d derivative = _mm256_div_pd(_mm256_sub_pd(error, _mm256_loadu_pd(a.prev_error + i)), dt);
+        __m256d out = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(a.kp + i), error),
+                                                  _mm256_mul_pd(_mm256_loadu_pd(a.ki + i), integral)),
+                                    _mm256_mul_pd(_mm256_loadu_pd(a.kd + i), derivative));
+        _mm256_storeu_pd(a.output + i, out);
+        _mm256_storeu_pd(a.integral + i, integral);
+        _mm256_storeu_pd(a.prev_error + i, error);
+    }
+    pid_scalar(a, i, count);
+}
+
+__attribute__((target("avx2"))) inline void pid_avx2(const PIDArrays<float> &a, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 error = _mm256_sub_ps(_mm256_loadu_ps(a.setpoint + i), _mm256_loadu_ps(a.measurement + i));
+        __m256 dt = _mm256_loadu_ps(a.dt + i);
+        __m256 integral = _mm256_add_ps(_mm256_loadu_ps(a.integral + i), _mm256_mul_ps(error, dt));
+        __m256 derivative = _mm256_div_ps(_mm256_sub_ps(error, _mm256_loadu_ps(a.prev_error + i)), dt);
+        __m256 out = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a.kp + i), error),
+                                                 _mm256_mul_ps(_mm256_loadu_ps(a.ki + i), integral)),
+                                   _mm256_mul_ps(_mm256_loadu_ps(a.kd + i), derivative));
+        _mm256_storeu_ps(a.output + i, out);
+        _mm256_storeu_ps(a.integral + i, integral);
+        _mm256_storeu_ps(a.prev_error + i, error);
+    }
+    pid_scalar(a, i, count);
+}
+
+__attribute__((target("avx512f"))) inline void pid_avx512(const PIDArrays<double> &a, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d error = _mm512_sub_pd(_mm512_loadu_pd(a.setpoint + i), _mm512_loadu_pd(a.measurement + i));
+        __m512d dt = _mm512_loadu_pd(a.dt + i);
+        __m512d integral = _mm512_add_pd(_mm512_loadu_pd(a.integral + i), _mm512_mul_pd(error, dt));
+        __m512d derivative = _mm512_div_pd(_mm512_sub_pd(error, _mm512_loadu_pd(a.prev_error + i)), dt);
+        __m512d out = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(a.kp + i), error),
+                                                  _mm512_mul_pd(_mm512_loadu_pd(a.ki + i), integral)),
+                                    _mm512_mul_pd(_mm512_loadu_pd(a.kd + i), derivative));
+        _mm512_storeu_pd(a.output + i, out);
+        _mm512_storeu_pd(a.integral + i, integral);
+        _mm512_storeu_pd(a.prev_error + i, error);
+    }
+    pid_scalar(a, i, count);
+}
+
+__attribute__((target("avx512f"))) inline void pid_avx512(const PIDArrays<float> &a, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 error = _mm512_sub_ps(_mm512_loadu_ps(a.setpoint + i), _mm512_loadu_ps(a.measurement + i));
+        __m512 dt = _mm512_loadu_ps(a.dt + i);
+        __m512 integral = _mm512_add_ps(_mm512_loadu_ps(a.integral + i), _mm512_mul_ps(error, dt));
+        __m512 derivative = _mm512_div_ps(_mm512_sub_ps(error, _mm512_loadu_ps(a.prev_error + i)), dt);
+        __m512 out = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(a.kp + i), error),
+                                                 _mm512_mul_ps(_mm512_loadu_ps(a.ki + i), integral)),
+                                   _mm512_mul_ps(_mm512_loadu_ps(a.kd + i), derivative));
+        _mm512_storeu_ps(a.output + i, out);
+        _mm512_storeu_ps(a.integral + i, integral);
+        _mm512_storeu_ps(a.prev_error + i, error);
+    }
+    pid_scalar(a, i, count);
+}
+#endif
+
+template <typename T>
+class PIDBatch {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "PIDBatch<T>: T为float或double");
+
+public:
+    // isa默认取CPU支持的最高指令集，指定更高的指令集时降为检测结果
+    explicit PIDBatch(Isa isa = detect_isa())
+        : isa{isa > detect_isa() ? detect_isa() : isa} {}
+
+    // 添加回路，返回下标
+    size_t add(T kp, T ki, T kd, T setpoint) {
+        kps.push_back(kp);
+        kis.push_back(ki);
+        kds.push_back(kd);
+        setpoints.push_back(setpoint);
+        integrals.push_back(0);
+        prev_errors.push_back(0);
+        return kps.size() - 1;
+    }
+
+    void reserve(size_t count) {
+        for (auto *v : {&kps, &kis, &kds, &setpoints, &integrals, &prev_errors}) {
+            v->reserve(count);
+        }
+    }
+
+    void set_setpoint(size_t i, T setpoint) { setpoints[i] = setpoint; }
+    void set_gains(size_t i, T kp, T ki, T kd) {
+        kps[i] = kp;
+        kis[i] = ki;
+        kds[i] = kd;
+    }
+
+    // 清零积分与上次误差
+    void reset(size_t i) {
+        integrals[i] = 0;
+        prev_errors[i] = 0;
+    }
+
+    // 更新全部回路: measurement/dt/output长度均为size()，dt必须大于0
+    void update(const T *measurement, const T *dt, T *output) {
+        PIDArrays<T> arrays{kps.data(),       kis.data(),         kds.data(), setpoints.data(), integrals.data(),
+                            prev_errors.data(), measurement, dt,         output};
+        size_t count = kps.size();
+#if defined(__x86_64__) || defined(__i386__)
+        if (isa == Isa::AVX512) {
+            pid_avx512(arrays, count);
+            return;
+        }
+        if (isa == Isa::AVX2) {
+            pid_avx2(arrays, count);
+            return;
+        }
+#endif
+        pid_scalar(arrays, 0, count);
+    }
+
+    size_t size() const { return kps.size(); }
+    T integral(size_t i) const { return integrals[i]; }
+    T prev_error(size_t i) const { return prev_errors[i]; }
+    Isa kernel() const { return isa; }
+
+private:
+    Isa isa;
+    std::vector<T> kps;
+    std::vector<T> kis;
+    std::vector<T> kds;
+    std::vector<T> setpoints;
+    std::vector<T> integrals;
+    std::vector<T> prev_errors;
+};
+
+} // namespace my_pid
+
+#endif
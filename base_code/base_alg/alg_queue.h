@@ -0,0 +1,334 @@
+#ifndef _MY_QUEUE_H__
+#define _MY_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * 无锁有界队列，用于生产者/消费者流水线
+ * 1、spsc_queue: 单生产单消费环形缓冲，无等待；两端各自缓存对端下标，减少跨核读取
+ * 2、mpmc_queue: 多生产多消费有界队列(Vyukov)，每个槽位带序号
+ * 3、BLOCKING=true 时push/pop在满/空时通过futex休眠，false 时让出CPU自旋
+ */
+namespace my_queue {
+constexpr size_t CACHE_LINE = 64;
+
+// 等待事件，futex实现，非linux平台退化为让出CPU
+// waiting标记有人准备休眠，唤醒方清除标记后只需一次系统调用，连续发布不会重复唤醒
+class WaitEvent {
+public:
+    // 等待前先登记并读取序号，再复查条件，条件仍不满足才wait
+    uint32_t prepare_wait() {
+        waiting.store(true, std::memory_order_seq_cst);
+        return seq.load(std::memory_order_seq_cst);
+    }
+
+    // 序号已变化时立即返回
+    void wait(uint32_t expect) {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq), FUTEX_WAIT_PRIVATE, expect, nullptr, nullptr, 0);
+#else
+        (void)expect;
+        std::this_thread::yield();
+#endif
+    }
+
+    // 条件发布后调用，无等待者时只有一次读取
+    void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!waiting.load(std::memory_order_relaxed) || !waiting.exchange(false, std::memory_order_seq_cst)) {
+            return;
+        }
+        seq.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+private:
+    std::atomic<uint32_t> seq{0};
+    std::atomic<bool> waiting{false};
+};
+
+// 容量取不小于capacity的2的幂
+inline size_t round_up_pow2(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+// 单生产者单消费者
+template <typename T, bool BLOCKING = false>
+class spsc_queue {
+public:
+    explicit spsc_queue(size_t capacity = 1024)
+        : mask{round_up_pow2(capacity) - 1}
+        , buffer(mask + 1) {}
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+    ~spsc_queue() {
+        size_t tail = producer.index.load(std::memory_order_relaxed);
+        for (size_t i = consumer.index.load(std::memory_order_relaxed); i != tail; i++) {
+            buffer[i & mask].ptr()->~T();
+        }
+    }
+
+    // 非阻塞入队，满返回false
+    template <typename U>
+    bool try_push(U &&data) {
+        size_t tail = producer.index.load(std::memory_order_relaxed);
+        if (tail - producer.cached >= buffer.size()) {
+            producer.cached = consumer.index.load(std::memory_order_acquire);
+            if (tail - producer.cached >= buffer.size()) {
+                return false;
+            }
+        }
+        new (buffer[tail & mask].storage) T(std::forward<U>(data));
+        producer.index.store(tail + 1, std::memory_order_release);
+        if (BLOCKING) {
+            not_empty.notify_all();
+        }
+        return true;
+    }
+
+    // 非阻塞出队，空返回false
+    bool try_pop(T &data) {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        if (head == consumer.cached) {
+            consumer.cached = producer.index.load(std::memory_order_acquire);
+            if (head == consumer.cached) {
+                return false;
+            }
+        }
+        T *slot = buffer[head & mask].ptr();
+        data = std::move(*slot);
+        slot->~T();
+        consumer.index.store(head + 1, std::memory_order_release);
+        if (BLOCKING) {
+            not_full.notify_all();
+        }
+        return true;
+    }
+
+    // 阻塞入队
+    template <typename U>
+    void push(U &&data) {
+        while (!try_push(std::forward<U>(data))) {
+            wait_until(not_full, [this] { return !full(); });
+        }
+    }
+
+    // 阻塞出队
+    void pop(T &data) {
+        while (!try_pop(data)) {
+            wait_until(not_empty, [this] { return !empty(); });
+        }
+    }
+
+    bool empty() const {
+        return consumer.index.load(std::memory_order_acquire) == producer.index.load(std::memory_order_acquire);
+    }
+
+    bool full() const {
+        return producer.index.load(std::memory_order_acquire) - consumer.index.load(std::memory_order_acquire) >=
+               buffer.size();
+    }
+
+    size_t capacity() const {
+        return buffer.size();
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *ptr() {
+            return reinterpret_cast<T *>(storage);
+        }
+    };
+
+    // 各端下标与缓存的对端下标放在同一缓存行，两端互不干扰
+    struct alignas(CACHE_LINE) Index {
+        std::atomic<size_t> index{0};
+        size_t cached = 0;
+    };
+
+    template <typename Pred>
+    void wait_until(WaitEvent &event, Pred ready) {
+        if (!BLOCKING) {
+            std::this_thread::yield();
+            return;
+        }
+        uint32_t seq = event.prepare_wait();
+        if (!ready()) {
+            event.wait(seq);
+        }
+    }
+
+    const size_t mask;
+    std::vector<Slot> buffer;
+    Index producer; // 生产者写index，缓存消费者下标
+    Index consumer; // 消费者写index，缓存生产者下标
+    WaitEvent not_empty;
+    WaitEvent not_full;
+};
+
+// 多生产者多消费者(Vyukov有界队列)
+template <typename T, bool BLOCKING = false>
+class mpmc_queue {
+public:
+    explicit mpmc_queue(size_t capacity = 1024)
+        : mask{round_up_pow2(capacity) - 1}
+        , buffer(mask + 1) {
+        for (size_t i = 0; i < buffer.size(); i++) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+    ~mpmc_queue() {
+        size_t tail = enqueue_pos.value.load(std::memory_order_relaxed);
+        for (size_t i = dequeue_pos.value.load(std::memory_order_relaxed); i != tail; i++) {
+            buffer[i & mask].ptr()->~T();
+        }
+    }
+
+    // 非阻塞入队，满返回false
+    template <typename U>
+    bool try_push(U &&data) {
+        Cell *cell;
+        size_t pos = enqueue_pos.value.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &buffer[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                // 槽位空闲，抢占该位置
+                if (enqueue_pos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos.value.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::forward<U>(data));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        if (BLOCKING) {
+            not_empty.notify_all();
+        }
+        return true;
+    }
+
+    // 非阻塞出队，空返回false
+    bool try_pop(T &data) {
+        Cell *cell;
+        size_t pos = dequeue_pos.value.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &buffer[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos.value.load(std::memory_order_relaxed);
+            }
+        }
+        T *slot = cell->ptr();
+        data = std::move(*slot);
+        slot->~T();
+        // 序号推进一圈，供下一轮生产者使用
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        if (BLOCKING) {
+            not_full.notify_all();
+        }
+        return true;
+    }
+
+    // 阻塞入队
+    template <typename U>
+    void push(U &&data) {
+        while (!try_push(std::forward<U>(data))) {
+            wait_until(not_full, [this] { return !full(); });
+        }
+    }
+
+    // 阻塞出队
+    void pop(T &data) {
+        while (!try_pop(data)) {
+            wait_until(not_empty, [this] { return !empty(); });
+        }
+    }
+
+    // 近似判断，并发下仅作参考
+    bool empty() const {
+        size_t pos = dequeue_pos.value.load(std::memory_order_acquire);
+        return (intptr_t)buffer[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1) < 0;
+    }
+
+    bool full() const {
+        size_t pos = enqueue_pos.value.load(std::memory_order_acquire);
+        return (intptr_t)buffer[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)pos < 0;
+    }
+
+    size_t capacity() const {
+        return buffer.size();
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *ptr() {
+            return reinterpret_cast<T *>(storage);
+        }
+    };
+
+    struct alignas(CACHE_LINE) Pos {
+        std::atomic<size_t> value{0};
+    };
+
+    template <typename Pred>
+    void wait_until(WaitEvent &event, Pred ready) {
+        if (!BLOCKING) {
+            std::this_thread::yield();
+            return;
+        }
+        uint32_t seq = event.prepare_wait();
+        if (!ready()) {
+            event.wait(seq);
+        }
+    }
+
+    const size_t mask;
+    std::vector<Cell> buffer;
+    Pos enqueue_pos;
+    Pos dequeue_pos;
+    WaitEvent not_empty;
+    WaitEvent not_full;
+};
+
+} // namespace my_queue
+
+#endif
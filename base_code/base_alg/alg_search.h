@@ -0,0 +1,2757 @@
+#ifndef _MY_SEARCH_H__
+#define _MY_SEARCH_H__
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * 路径搜索
+ * 1、MySearch: 深度/广度搜索左上到右下，A*与双向BFS返回真实最短路径
+ * 2、GridSearcher: 可复用的网格搜索器，扁平下标+父节点数组还原路径，
+ *    访问标记使用代数(generation)戳，查询之间不清零暂存数组
+ * 3、BitGrid: 每格1位，行按64位补齐；FrontierBFS整层按字做移位/与运算扩展
+ * 4、GridView: 不拥有数据的行主序网格视图，外部缓冲区直接传入，不复制
+ * 5、JumpTable: JPS+预计算的八方向跳跃距离，可存盘，同一地图只需计算一次
+ * 6、ParallelBFS: 多线程按层同步BFS，自上而下/自下而上按前沿大小切换，求全图距离场
+ * 7、ComponentIndex: 并查集连通块标号，连通查询为标号比较，支持增量开关格子
+ * 8、HierarchicalSearcher: HPA*分层寻路，格子变化只重算所在簇及相邻簇
+ * 9、CostGrid/WeightedSearcher: 整数权值(1~255)网格，Dial桶队列与基数堆Dijkstra，多源距离变换
+ * 10、TiledGrid: 分块存盘的超大网格，mmap按需读块，LRU限制常驻块数；SparseSearcher暂存按访问量分配
+ */
+namespace my_search {
+using Point = std::pair<int, int>; // (行x, 列y)
+
+// vector<vector<int>>网格访问器，非0可通行
+class VectorGrid {
+public:
+    explicit VectorGrid(const std::vector<std::vector<int>> &array)
+        : array{array} {}
+
+    int rows() const { return (int)array.size(); }
+    int cols() const { return array.empty() ? 0 : (int)array[0].size(); }
+    bool passable(int x, int y) const { return array[x][y] != 0; }
+    int cost(int x, int y) const { return array[x][y]; } // 进入该格的代价，0为障碍
+
+private:
+    const std::vector<std::vector<int>> &array;
+};
+
+// 行主序连续缓冲区的网格视图(类似span)，非0可通行，stride为行距(元素数)
+class GridView {
+public:
+    GridView(const int *data, int rows, int cols, int stride = 0)
+        : data{data}
+        , row_cnt{rows}
+        , col_cnt{cols}
+        , stride{stride > 0 ? stride : cols} {}
+
+    explicit GridView(const std::vector<int> &cells, int cols)
+        : GridView(cells.data(), cols > 0 ? (int)(cells.size() / cols) : 0, cols) {}
+
+    int rows() const { return row_cnt; }
+    int cols() const { return col_cnt; }
+    bool passable(int x, int y) const { return data[(size_t)x * stride + y] != 0; }
+    int cost(int x, int y) const { return data[(size_t)x * stride + y]; }
+
+private:
+    const int *data;
+    int row_cnt;
+    int col_cnt;
+    int stride;
+};
+
+struct JumpTableHeader {
+    uint32_t magic;     // JUMP_TABLE_MAGIC
+    int32_t rows;
+    int32_t cols;
+    uint32_t reserved;
+    uint64_t grid_hash; // 可通行位的FNV-1a，加载时校验地图是否一致
+};
+constexpr uint32_t JUMP_TABLE_MAGIC = 0x2B53504A; // "JPS+"
+
+/**
+ * JPS+跳跃距离表(八方向，不允许斜穿障碍角)
+ * 1、每格每方向一个有符号距离: >0为到下一个跳点的步数，<=0为到障碍/边界前可走的步数(取负)
+ * 2、直走跳点: 当前格某侧可通行而其后方同侧被挡(强制邻居)
+ *    斜走跳点: 在两个分量方向上直走能遇到跳点
+ * 3、jump_distance在线计算同一距离(普通JPS)，build按方向整图扫描一次得到全表
+ * 4、距离用int16存储，行列数不超过32767
+ */
+class JumpTable {
+public:
+    // 方向顺序与GridSearcher相同: 前4个直走，后4个斜走
+    static constexpr int DIRS[8][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    static constexpr int MAX_SIDE = 32767;
+
+    int rows() const { return row_cnt; }
+    int cols() const { return col_cnt; }
+    bool empty() const { return dist.empty(); }
+
+    int distance(int x, int y, int d) const {
+        return dist[((size_t)x * col_cnt + y) * 8 + d];
+    }
+
+    // 预计算全表，网格过大返回false
+    template <typename Grid>
+    bool build(const Grid &grid) {
+        row_cnt = grid.rows();
+        col_cnt = grid.cols();
+        if (row_cnt > MAX_SIDE || col_cnt > MAX_SIDE) {
+            row_cnt = col_cnt = 0;
+            dist.clear();
+            return false;
+        }
+        dist.assign((size_t)row_cnt * col_cnt * 8, 0);
+        grid_hash = hash_grid(grid);
+        // 先直走后斜走: 斜走距离依赖下一格的直走距离；按方向反向扫描，下一格总是先算好
+        for (int d = 0; d < 8; d++) {
+            int a = DIRS[d][0], b = DIRS[d][1];
+            for (int i = 0; i < row_cnt; i++) {
+                int x = a > 0 ? row_cnt - 1 - i : i;
+                for (int j = 0; j < col_cnt; j++) {
+                    int y = b > 0 ? col_cnt - 1 - j : j;
+                    int next_x = x + a, next_y = y + b;
+                    if (!step_ok(grid, x, y, d))
+                        continue;
+                    int next = distance(next_x, next_y, d);
+                    bool jump = d < 4 ? forced(grid, next_x, next_y, d)
+                                      : (distance(next_x, next_y, component(a, 0)) > 0 ||
+                                         distance(next_x, next_y, component(0, b)) > 0);
+                    at(x, y, d) = (int16_t)(jump ? 1 : (next > 0 ? next + 1 : next - 1));
+                }
+            }
+        }
+        return true;
+    }
+
+    // 在线计算(x, y)沿方向d的跳跃距离，与表中取值一致
+    template <typename Grid>
+    static int jump_distance(const Grid &grid, int x, int y, int d) {
+        int a = DIRS[d][0], b = DIRS[d][1];
+        for (int k = 1;; k++) {
+            if (!step_ok(grid, x, y, d))
+                return -(k - 1);
+            x += a;
+            y += b;
+            if (d < 4 ? forced(grid, x, y, d)
+                      : (jump_distance(grid, x, y, component(a, 0)) > 0 || jump_distance(grid, x, y, component(0, b)) > 0))
+                return k;
+        }
+    }
+
+    // 网格可通行位的指纹
+    template <typename Grid>
+    static uint64_t hash_grid(const Grid &grid) {
+        uint64_t hash = 1469598103934665603ull;
+        for (int x = 0; x < grid.rows(); x++) {
+            for (int y = 0; y < grid.cols(); y++) {
+                hash = (hash ^ (grid.passable(x, y) ? 1u : 0u)) * 1099511628211ull;
+            }
+        }
+        return hash ^ ((uint64_t)grid.rows() << 32 | (uint32_t)grid.cols());
+    }
+
+    // 存盘: 头部 + 距离数组
+    bool save(const std::string &path) const {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        JumpTableHeader header{JUMP_TABLE_MAGIC, row_cnt, col_cnt, 0, grid_hash};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(dist.data()), dist.size() * sizeof(int16_t));
+        return file.good();
+    }
+
+    // 加载，文件损坏或与grid不一致返回false
+    template <typename Grid>
+    bool load(const std::string &path, const Grid &grid) {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            return false;
+        JumpTableHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+            return false;
+        if (header.magic != JUMP_TABLE_MAGIC || header.rows != grid.rows() || header.cols != grid.cols())
+            return false;
+        if (header.grid_hash != hash_grid(grid))
+            return false;
+        std::vector<int16_t> data((size_t)header.rows * header.cols * 8);
+        if (!file.read(reinterpret_cast<char *>(data.data()), data.size() * sizeof(int16_t)))
+            return false;
+        row_cnt = header.rows;
+        col_cnt = header.cols;
+        grid_hash = header.grid_hash;
+        dist.swap(data);
+        return true;
+    }
+
+private:
+    // 直走方向(a, b)对应的下标
+    static int component(int a, int b) {
+        return a > 0 ? 1 : (a < 0 ? 3 : (b > 0 ? 0 : 2));
+    }
+
+    template <typename Grid>
+    static bool open(const Grid &grid, int x, int y) {
+        return x >= 0 && x < grid.rows() && y >= 0 && y < grid.cols() && grid.passable(x, y);
+    }
+
+    // 从(x, y)沿d走一步是否合法，斜走要求两侧直邻格可通行
+    template <typename Grid>
+    static bool step_ok(const Grid &grid, int x, int y, int d) {
+        int a = DIRS[d][0], b = DIRS[d][1];
+        if (!open(grid, x + a, y + b))
+            return false;
+        return d < 4 || (open(grid, x + a, y) && open(grid, x, y + b));
+    }
+
+    // 沿直走方向d到达(x, y)时是否有强制邻居
+    template <typename Grid>
+    static bool forced(const Grid &grid, int x, int y, int d) {
+        int a = DIRS[d][0], b = DIRS[d][1];
+        for (int side : {1, -1}) {
+            int qa = b * side, qb = a * side; // 垂直方向
+            if (open(grid, x + qa, y + qb) && !open(grid, x - a + qa, y - b + qb))
+                return true;
+        }
+        return false;
+    }
+
+    int16_t &at(int x, int y, int d) {
+        return dist[((size_t)x * col_cnt + y) * 8 + d];
+    }
+
+    int row_cnt = 0;
+    int col_cnt = 0;
+    uint64_t grid_hash = 0;
+    std::vector<int16_t> dist; // 每格连续8个方向
+};
+
+/**
+ * 网格搜索，Grid需提供rows()/cols()/passable(x, y)
+ * 1、astar: 四方向用曼哈顿启发；八方向用octile启发，不允许斜穿障碍角
+ * 2、bidirectional_bfs: 两端按层交替扩展较小的一侧，相遇层扩展完后取最短
+ * 3、dfs/connected: 显式栈的深度搜索，不受线程栈大小限制；connected只判连通，首次到达即返回
+ * 4、jps: 八方向跳点搜索，只把跳点放入开放集；传入JumpTable时为JPS+，跳跃距离查表
+ * 5、暂存数组按最大网格分配一次，每次查询只递增代数；expanded()为上次A*或JPS的出堆节点数
+ */
+class GridSearcher {
+public:
+    static constexpr int STRAIGHT_COST = 10; // 直走代价
+    static constexpr int DIAGONAL_COST = 14; // 斜走代价(约10*sqrt(2))
+
+    // A*搜索start到goal，找到时path为起点到终点的格子序列
+    template <typename Grid>
+    bool astar(const Grid &grid, Point start, Point goal, std::vector<Point> &path, bool diagonal = false) {
+        path.clear();
+        if (!prepare(grid, start, goal))
+            return false;
+        int rows = grid.rows(), cols = grid.cols();
+        int start_idx = start.first * cols + start.second;
+        int goal_idx = goal.first * cols + goal.second;
+        int dir_cnt = diagonal ? 8 : 4;
+
+        open.clear();
+        expanded_cnt = 0;
+        visit(start_idx, 0, -1);
+        push_open(heuristic(start, goal, diagonal), 0, start_idx);
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), OpenCompare());
+            OpenEntry cur = open.back();
+            open.pop_back();
+            // 懒删除: 已关闭或已有更优g的重复项
+            if (closed[cur.idx] == generation || cur.g != g_score[cur.idx])
+                continue;
+            closed[cur.idx] = generation;
+            expanded_cnt++;
+            if (cur.idx == goal_idx) {
+                build_path(goal_idx, cols, path);
+                return true;
+            }
+            int x = cur.idx / cols, y = cur.idx % cols;
+            for (int d = 0; d < dir_cnt; d++) {
+                int next_x = x + DIRS[d][0], next_y = y + DIRS[d][1];
+                if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols || !grid.passable(next_x, next_y))
+                    continue;
+                // 斜走要求两侧直邻格都可通行
+                if (d >= 4 && (!grid.passable(x, next_y) || !grid.passable(next_x, y)))
+                    continue;
+                int next_idx = next_x * cols + next_y;
+                if (closed[next_idx] == generation)
+                    continue;
+                int next_g = cur.g + (d >= 4 ? DIAGONAL_COST : STRAIGHT_COST);
+                if (stamp[next_idx] == generation && g_score[next_idx] <= next_g)
+                    continue;
+                visit(next_idx, next_g, cur.idx);
+                push_open(next_g + heuristic({next_x, next_y}, goal, diagonal), next_g, next_idx);
+            }
+        }
+        return false;
+    }
+
+    // 跳点搜索(八方向，与astar(diagonal=true)代价相同)；table非空且与网格尺寸一致时查表(JPS+)
+    template <typename Grid>
+    bool jps(const Grid &grid, Point start, Point goal, std::vector<Point> &path, const JumpTable *table = nullptr) {
+        if (table != nullptr && (table->rows() != grid.rows() || table->cols() != grid.cols())) {
+            path.clear();
+            return false;
+        }
+        if (table != nullptr)
+            return jump_search(grid, start, goal, path,
+                               [table](int x, int y, int d) { return table->distance(x, y, d); });
+        return jump_search(grid, start, goal, path,
+                           [&grid](int x, int y, int d) { return JumpTable::jump_distance(grid, x, y, d); });
+    }
+
+    int expanded() const {
+        return expanded_cnt;
+    }
+
+    // 深度搜索(四方向)，找到时path为栈中的一条路径(不保证最短)
+    template <typename Grid>
+    bool dfs(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        path.clear();
+        if (!prepare(grid, start, goal))
+            return false;
+        int rows = grid.rows(), cols = grid.cols();
+        int goal_idx = goal.first * cols + goal.second;
+
+        // 栈帧: 格子下标 + 下一个要尝试的方向，栈内容即当前路径
+        dfs_stack.clear();
+        dfs_stack.push_back({start.first * cols + start.second, 0});
+        stamp[dfs_stack.back().first] = generation;
+        while (!dfs_stack.empty()) {
+            auto &top = dfs_stack.back();
+            if (top.first == goal_idx) {
+                path.reserve(dfs_stack.size());
+                for (auto &frame : dfs_stack) {
+                    path.push_back({frame.first / cols, frame.first % cols});
+                }
+                return true;
+            }
+            if (top.second == 4) {
+                dfs_stack.pop_back();
+                continue;
+            }
+            int d = top.second++;
+            int next_x = top.first / cols + DIRS[d][0], next_y = top.first % cols + DIRS[d][1];
+            if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols || !grid.passable(next_x, next_y))
+                continue;
+            int next_idx = next_x * cols + next_y;
+            if (stamp[next_idx] == generation)
+                continue;
+            stamp[next_idx] = generation;
+            dfs_stack.push_back({next_idx, 0});
+        }
+        return false;
+    }
+
+    // 只判断start与goal是否连通(四方向)，不记录路径，首次到达即返回
+    template <typename Grid>
+    bool connected(const Grid &grid, Point start, Point goal) {
+        if (!prepare(grid, start, goal))
+            return false;
+        int rows = grid.rows(), cols = grid.cols();
+        int goal_idx = goal.first * cols + goal.second;
+        int start_idx = start.first * cols + start.second;
+        if (start_idx == goal_idx)
+            return true;
+        index_stack.assign(1, start_idx);
+        stamp[start_idx] = generation;
+        while (!index_stack.empty()) {
+            int idx = index_stack.back();
+            index_stack.pop_back();
+            int x = idx / cols, y = idx % cols;
+            for (int d = 0; d < 4; d++) {
+                int next_x = x + DIRS[d][0], next_y = y + DIRS[d][1];
+                if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols || !grid.passable(next_x, next_y))
+                    continue;
+                int next_idx = next_x * cols + next_y;
+                if (next_idx == goal_idx)
+                    return true;
+                if (stamp[next_idx] == generation)
+                    continue;
+                stamp[next_idx] = generation;
+                index_stack.push_back(next_idx);
+            }
+        }
+        return false;
+    }
+
+    // 双向BFS(四方向)，找到时path为起点到终点的最短格子序列
+    template <typename Grid>
+    bool bidirectional_bfs(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        path.clear();
+        if (!prepare(grid, start, goal))
+            return false;
+        int rows = grid.rows(), cols = grid.cols();
+        int start_idx = start.first * cols + start.second;
+        int goal_idx = goal.first * cols + goal.second;
+        if (start_idx == goal_idx) {
+            path.push_back(start);
+            return true;
+        }
+
+        frontier[0].assign(1, start_idx);
+        frontier[1].assign(1, goal_idx);
+        visit(start_idx, 0, -1);
+        visit(goal_idx, 0, -1);
+        side[start_idx] = 0;
+        side[goal_idx] = 1;
+
+        int best_len = -1, meet_from = -1, meet_to = -1;
+        while (best_len < 0 && !frontier[0].empty() && !frontier[1].empty()) {
+            int s = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+            next_frontier.clear();
+            for (int idx : frontier[s]) {
+                int x = idx / cols, y = idx % cols;
+                for (int d = 0; d < 4; d++) {
+                    int next_x = x + DIRS[d][0], next_y = y + DIRS[d][1];
+                    if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols ||
+                        !grid.passable(next_x, next_y))
+                        continue;
+                    int next_idx = next_x * cols + next_y;
+                    if (stamp[next_idx] != generation) {
+                        visit(next_idx, g_score[idx] + 1, idx);
+                        side[next_idx] = (uint8_t)s;
+                        next_frontier.push_back(next_idx);
+                    } else if (side[next_idx] != s) {
+                        // 相遇: 本层内取最短的一对
+                        int len = g_score[idx] + 1 + g_score[next_idx];
+                        if (best_len < 0 || len < best_len) {
+                            best_len = len;
+                            meet_from = idx;
+                            meet_to = next_idx;
+                        }
+                    }
+                }
+            }
+            frontier[s].swap(next_frontier);
+        }
+        if (best_len < 0)
+            return false;
+
+        // 保证meet_from在正向一侧
+        if (side[meet_from] == 1)
+            std::swap(meet_from, meet_to);
+        build_path(meet_from, cols, path);
+        for (int idx = meet_to; idx != -1; idx = parent[idx]) {
+            path.push_back({idx / cols, idx % cols});
+        }
+        return true;
+    }
+
+private:
+    struct OpenEntry {
+        int f;
+        int g;
+        int idx;
+    };
+
+    // f小优先，f相同时g大(离终点近)优先
+    struct OpenCompare {
+        bool operator()(const OpenEntry &a, const OpenEntry &b) const {
+            if (a.f != b.f)
+                return a.f > b.f;
+            return a.g < b.g;
+        }
+    };
+
+    // 前4个为直走，后4个为斜走
+    static constexpr int DIRS[8][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    static int heuristic(Point a, Point b, bool diagonal) {
+        int dx = std::abs(a.first - b.first);
+        int dy = std::abs(a.second - b.second);
+        if (!diagonal)
+            return STRAIGHT_COST * (dx + dy);
+        return STRAIGHT_COST * (dx + dy) + (DIAGONAL_COST - 2 * STRAIGHT_COST) * std::min(dx, dy);
+    }
+
+    // 到达方向d之后需要继续尝试的方向，8为起点(全部方向)
+    static int successor_dirs(int d, int *dirs) {
+        if (d == 8) {
+            for (int i = 0; i < 8; i++) {
+                dirs[i] = i;
+            }
+            return 8;
+        }
+        int a = DIRS[d][0], b = DIRS[d][1];
+        if (d >= 4) {
+            dirs[0] = d;
+            dirs[1] = dir_index(a, 0);
+            dirs[2] = dir_index(0, b);
+            return 3;
+        }
+        // 直走: 前方、两侧及两个前斜方向，被挡的方向跳跃距离为0自然跳过
+        dirs[0] = d;
+        dirs[1] = dir_index(b, a);
+        dirs[2] = dir_index(-b, -a);
+        dirs[3] = dir_index(a + b, b + a);
+        dirs[4] = dir_index(a - b, b - a);
+        return 5;
+    }
+
+    static int dir_index(int a, int b) {
+        for (int d = 0; d < 8; d++) {
+            if (DIRS[d][0] == a && DIRS[d][1] == b)
+                return d;
+        }
+        return -1;
+    }
+
+    static int sign(int v) {
+        return (v > 0) - (v < 0);
+    }
+
+    // JPS/JPS+共用的搜索主循环，distance(x, y, d)返回JumpTable定义的有符号跳跃距离
+    template <typename Grid, typename Distance>
+    bool jump_search(const Grid &grid, Point start, Point goal, std::vector<Point> &path, Distance &&distance) {
+        path.clear();
+        if (!prepare(grid, start, goal))
+            return false;
+        int cols = grid.cols();
+        int start_idx = start.first * cols + start.second;
+        int goal_idx = goal.first * cols + goal.second;
+
+        open.clear();
+        expanded_cnt = 0;
+        visit(start_idx, 0, -1);
+        side[start_idx] = 8;
+        push_open(heuristic(start, goal, true), 0, start_idx);
+        int dirs[8];
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), OpenCompare());
+            OpenEntry cur = open.back();
+            open.pop_back();
+            if (closed[cur.idx] == generation || cur.g != g_score[cur.idx])
+                continue;
+            closed[cur.idx] = generation;
+            expanded_cnt++;
+            if (cur.idx == goal_idx) {
+                build_jump_path(goal_idx, cols, path);
+                return true;
+            }
+            int x = cur.idx / cols, y = cur.idx % cols;
+            int dir_cnt = successor_dirs(side[cur.idx], dirs);
+            for (int i = 0; i < dir_cnt; i++) {
+                int d = dirs[i];
+                int a = DIRS[d][0], b = DIRS[d][1];
+                int dist = distance(x, y, d);
+                int reach = std::abs(dist);
+                int steps = dist > 0 ? dist : 0;
+                // 终点在该方向上且在可走范围内时直接落到终点(直走)或终点所在行/列(斜走)
+                int gx = goal.first - x, gy = goal.second - y;
+                if (d < 4) {
+                    int along = a != 0 ? gx * a : gy * b;
+                    if ((a != 0 ? gy : gx) == 0 && along > 0 && along <= reach)
+                        steps = along;
+                } else if (sign(gx) == a && sign(gy) == b) {
+                    int m = std::min(std::abs(gx), std::abs(gy));
+                    if (m <= reach)
+                        steps = m;
+                }
+                if (steps == 0)
+                    continue;
+                int next_x = x + a * steps, next_y = y + b * steps;
+                int next_idx = next_x * cols + next_y;
+                if (closed[next_idx] == generation)
+                    continue;
+                int next_g = cur.g + steps * (d >= 4 ? DIAGONAL_COST : STRAIGHT_COST);
+                if (stamp[next_idx] == generation && g_score[next_idx] <= next_g)
+                    continue;
+                visit(next_idx, next_g, cur.idx);
+                side[next_idx] = (uint8_t)d;
+                push_open(next_g + heuristic({next_x, next_y}, goal, true), next_g, next_idx);
+            }
+        }
+        return false;
+    }
+
+    // 跳点之间都是直线或45度斜线，逐格展开
+    void build_jump_path(int idx, int cols, std::vector<Point> &path) {
+        jump_points.clear();
+        build_path(idx, cols, jump_points);
+        path.push_back(jump_points.front());
+        for (size_t i = 1; i < jump_points.size(); i++) {
+            Point p = jump_points[i - 1];
+            int a = sign(jump_points[i].first - p.first), b = sign(jump_points[i].second - p.second);
+            while (p != jump_points[i]) {
+                p.first += a;
+                p.second += b;
+                path.push_back(p);
+            }
+        }
+    }
+
+    // 校验端点，按需扩容暂存数组并进入新一代
+    template <typename Grid>
+    bool prepare(const Grid &grid, Point start, Point goal) {
+        int rows = grid.rows(), cols = grid.cols();
+        for (const Point &p : {start, goal}) {
+            if (p.first < 0 || p.first >= rows || p.second < 0 || p.second >= cols || !grid.passable(p.first, p.second))
+                return false;
+        }
+        size_t cells = (size_t)rows * cols;
+        if (cells > stamp.size()) {
+            stamp.assign(cells, 0);
+            closed.assign(cells, 0);
+            g_score.resize(cells);
+            parent.resize(cells);
+            side.resize(cells);
+            generation = 0;
+        }
+        // 代数回绕时清零一次
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(closed.begin(), closed.end(), 0);
+            generation = 1;
+        }
+        return true;
+    }
+
+    void visit(int idx, int g, int from) {
+        stamp[idx] = generation;
+        g_score[idx] = g;
+        parent[idx] = from;
+    }
+
+    void push_open(int f, int g, int idx) {
+        open.push_back({f, g, idx});
+        std::push_heap(open.begin(), open.end(), OpenCompare());
+    }
+
+    // 沿父节点回溯到起点，输出起点到idx的路径
+    void build_path(int idx, int cols, std::vector<Point> &path) {
+        size_t begin = path.size();
+        for (; idx != -1; idx = parent[idx]) {
+            path.push_back({idx / cols, idx % cols});
+        }
+        std::reverse(path.begin() + begin, path.end());
+    }
+
+    uint32_t generation = 0;
+    std::vector<uint32_t> stamp;   // 本代已发现
+    std::vector<uint32_t> closed;  // 本代已出堆(A*)
+    std::vector<int> g_score;      // 起点(或终点)到该格的代价
+    std::vector<int> parent;       // 父格子扁平下标，-1为根
+    std::vector<uint8_t> side;     // 双向BFS: 0正向 1反向；JPS: 到达方向，8为起点
+    std::vector<OpenEntry> open;   // A*开放集(二叉堆)
+    std::vector<int> frontier[2];  // 双向BFS当前层
+    std::vector<int> next_frontier;
+    std::vector<std::pair<int, int>> dfs_stack; // 深度搜索栈帧(下标, 下一方向)
+    std::vector<int> index_stack;               // 连通判断栈
+    std::vector<Point> jump_points;             // JPS父节点回溯得到的跳点序列
+    int expanded_cnt = 0;
+};
+
+/**
+ * 位图网格，1为可通行
+ * 每行补齐到64位整数倍，补齐位恒为0，行内第y列对应第y/64个字的第y%64位
+ */
+class BitGrid {
+public:
+    BitGrid() = default;
+    BitGrid(int rows, int cols)
+        : row_cnt{rows}
+        , col_cnt{cols}
+        , words{(cols + 63) / 64}
+        , bits((size_t)rows * ((cols + 63) / 64), 0) {}
+
+    // 由vector<vector<int>>构造，非0可通行
+    static BitGrid from_array(const std::vector<std::vector<int>> &array) {
+        BitGrid grid((int)array.size(), array.empty() ? 0 : (int)array[0].size());
+        for (int x = 0; x < grid.row_cnt; x++) {
+            for (int y = 0; y < grid.col_cnt; y++) {
+                grid.set(x, y, array[x][y] != 0);
+            }
+        }
+        return grid;
+    }
+
+    int rows() const { return row_cnt; }
+    int cols() const { return col_cnt; }
+    int words_per_row() const { return words; }
+
+    bool passable(int x, int y) const {
+        return (bits[(size_t)x * words + (y >> 6)] >> (y & 63)) & 1;
+    }
+
+    void set(int x, int y, bool open) {
+        uint64_t &word = bits[(size_t)x * words + (y >> 6)];
+        uint64_t mask = 1ull << (y & 63);
+        word = open ? (word | mask) : (word & ~mask);
+    }
+
+    const uint64_t *row(int x) const {
+        return bits.data() + (size_t)x * words;
+    }
+
+private:
+    int row_cnt = 0;
+    int col_cnt = 0;
+    int words = 0;
+    std::vector<uint64_t> bits;
+};
+
+/**
+ * 位图网格上的整层BFS(四方向)
+ * 1、run: 下一层 = (左右移位 | 上下行) & 可通行 & ~已访问，每次处理64格；
+ *    只处理当前层非0字及其上下左右的字，层稀疏时不扫描整行
+ * 2、reach: 只求可达集合，逐行上下扫描，行内沿连续可通行段一次填满，直到不再变化
+ * 3、暂存位图跨查询复用
+ */
+class FrontierBFS {
+public:
+    // 从start逐层扩展，goal有效时到达即停；返回到goal的步数，不可达或未给goal返回-1
+    // dist非空时写入每格步数(未到达为-1)
+    int run(const BitGrid &grid, Point start, Point goal = {-1, -1}, std::vector<int> *dist = nullptr) {
+        int rows = grid.rows(), cols = grid.cols(), words = grid.words_per_row();
+        layer_cnt = 0;
+        size_t total = (size_t)rows * words;
+        visited.assign(total, 0);
+        frontier.assign(total, 0);
+        next.assign(total, 0);
+        mark.assign(total, 0);
+        active.clear();
+        if (dist != nullptr)
+            dist->assign((size_t)rows * cols, -1);
+        if (!valid_start(grid, start))
+            return -1;
+        bool has_goal = goal.first >= 0 && goal.first < rows && goal.second >= 0 && goal.second < cols;
+        size_t goal_word = has_goal ? (size_t)goal.first * words + (goal.second >> 6) : 0;
+        uint64_t goal_mask = has_goal ? 1ull << (goal.second & 63) : 0;
+
+        size_t start_word = (size_t)start.first * words + (start.second >> 6);
+        frontier[start_word] = visited[start_word] = 1ull << (start.second & 63);
+        active.push_back(start_word);
+        const uint64_t *open = grid.row(0);
+        for (int layer = 0;; layer++) {
+            if (dist != nullptr)
+                write_layer(words, cols, layer, *dist);
+            layer_cnt = layer + 1;
+            if (has_goal && (frontier[goal_word] & goal_mask))
+                return layer;
+
+            // 候选字: 当前层字本身及上下左右，mark按层去重
+            uint32_t stamp = (uint32_t)layer + 1;
+            candidates.clear();
+            for (size_t idx : active) {
+                size_t w = idx % words;
+                size_t around[5] = {idx, idx - 1, idx + 1, idx - words, idx + words};
+                bool ok[5] = {true, w > 0, w + 1 < (size_t)words, idx >= (size_t)words, idx + words < total};
+                for (int i = 0; i < 5; i++) {
+                    if (ok[i] && mark[around[i]] != stamp) {
+                        mark[around[i]] = stamp;
+                        candidates.push_back(around[i]);
+                    }
+                }
+            }
+            next_active.clear();
+            for (size_t idx : candidates) {
+                size_t w = idx % words;
+                uint64_t word = frontier[idx];
+                // 右移一列: 低位进位来自前一个字的最高位；左移一列同理
+                uint64_t reach = (word << 1) | (w > 0 ? frontier[idx - 1] >> 63 : 0);
+                reach |= (word >> 1) | (w + 1 < (size_t)words ? frontier[idx + 1] << 63 : 0);
+                if (idx >= (size_t)words)
+                    reach |= frontier[idx - words];
+                if (idx + words < total)
+                    reach |= frontier[idx + words];
+                reach &= open[idx] & ~visited[idx];
+                if (reach != 0) {
+                    next[idx] = reach;
+                    visited[idx] |= reach;
+                    next_active.push_back(idx);
+                }
+            }
+            // 清掉旧层，交换
+            for (size_t idx : active) {
+                frontier[idx] = 0;
+            }
+            frontier.swap(next);
+            active.swap(next_active);
+            if (active.empty())
+                return -1;
+        }
+    }
+
+    // 只求从start可达的集合(结果见reached())，返回可达格数
+    long reach(const BitGrid &grid, Point start) {
+        int rows = grid.rows(), words = grid.words_per_row();
+        layer_cnt = 0;
+        visited.assign((size_t)rows * words, 0);
+        if (!valid_start(grid, start))
+            return 0;
+        visited[(size_t)start.first * words + (start.second >> 6)] = 1ull << (start.second & 63);
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            // 向下扫描把上一行的结果带下来，再向上扫描
+            for (int x = 0; x < rows; x++) {
+                changed |= sweep_row(grid, x, x - 1);
+            }
+            for (int x = rows - 1; x >= 0; x--) {
+                changed |= sweep_row(grid, x, x + 1);
+            }
+        }
+        long count = 0;
+        for (uint64_t word : visited) {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    // 最近一次run扩展的层数(含起点层)
+    int layers() const {
+        return layer_cnt;
+    }
+
+    // 最近一次run/reach的可达集合，与BitGrid同布局
+    const std::vector<uint64_t> &reached() const {
+        return visited;
+    }
+
+private:
+    static bool valid_start(const BitGrid &grid, Point start) {
+        return start.first >= 0 && start.first < grid.rows() && start.second >= 0 && start.second < grid.cols() &&
+               grid.passable(start.first, start.second);
+    }
+
+    // 种子沿可通行位向高位填满(Kogge-Stone)
+    static uint64_t fill_up(uint64_t gen, uint64_t pro) {
+        gen |= pro & (gen << 1);
+        pro &= pro << 1;
+        gen |= pro & (gen << 2);
+        pro &= pro << 2;
+        gen |= pro & (gen << 4);
+        pro &= pro << 4;
+        gen |= pro & (gen << 8);
+        pro &= pro << 8;
+        gen |= pro & (gen << 16);
+        pro &= pro << 16;
+        gen |= pro & (gen << 32);
+        return gen;
+    }
+
+    // 种子沿可通行位向低位填满
+    static uint64_t fill_down(uint64_t gen, uint64_t pro) {
+        gen |= pro & (gen >> 1);
+        pro &= pro >> 1;
+        gen |= pro & (gen >> 2);
+        pro &= pro >> 2;
+        gen |= pro & (gen >> 4);
+        pro &= pro >> 4;
+        gen |= pro & (gen >> 8);
+        pro &= pro >> 8;
+        gen |= pro & (gen >> 16);
+        pro &= pro >> 16;
+        gen |= pro & (gen >> 32);
+        return gen;
+    }
+
+    // 以本行已达 | 相邻行已达为种子，在本行连续可通行段内左右填满，返回是否有变化
+    bool sweep_row(const BitGrid &grid, int x, int from_row) {
+        int words = grid.words_per_row();
+        const uint64_t *open = grid.row(x);
+        uint64_t *row = &visited[(size_t)x * words];
+        const uint64_t *adjacent =
+            from_row >= 0 && from_row < grid.rows() ? &visited[(size_t)from_row * words] : nullptr;
+        bool changed = false;
+        // 向高位(右)逐字填充，字间通过最高位进位
+        uint64_t carry = 0;
+        for (int w = 0; w < words; w++) {
+            uint64_t seed = (row[w] | (adjacent ? adjacent[w] : 0) | carry) & open[w];
+            uint64_t filled = fill_up(seed, open[w]);
+            carry = filled >> 63;
+            if (filled != row[w]) {
+                row[w] |= filled;
+                changed = true;
+            }
+        }
+        // 向低位(左)逐字填充
+        carry = 0;
+        for (int w = words - 1; w >= 0; w--) {
+            uint64_t seed = (row[w] | carry) & open[w];
+            uint64_t filled = fill_down(seed, open[w]);
+            carry = (filled & 1) << 63;
+            if (filled != row[w]) {
+                row[w] = filled;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    void write_layer(int words, int cols, int layer, std::vector<int> &dist) const {
+        for (size_t idx : active) {
+            size_t x = idx / words, w = idx % words;
+            for (uint64_t word = frontier[idx]; word != 0; word &= word - 1) {
+                dist[x * cols + w * 64 + __builtin_ctzll(word)] = layer;
+            }
+        }
+    }
+
+    int layer_cnt = 0;
+    std::vector<uint64_t> visited;
+    std::vector<uint64_t> frontier;
+    std::vector<uint64_t> next;
+    std::vector<uint32_t> mark;         // 候选去重，值为层号+1
+    std::vector<size_t> active;         // 当前层非0字
+    std::vector<size_t> next_active;
+    std::vector<size_t> candidates;
+};
+
+// 自旋屏障，等待时让出CPU；线程数少于核数时开销远小于条件变量
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int count)
+        : count{count} {}
+
+    void wait() {
+        int phase = generation.load(std::memory_order_acquire);
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (generation.load(std::memory_order_acquire) == phase) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    int count;
+    std::atomic<int> waiting{0};
+    std::atomic<int> generation{0};
+};
+
+/**
+ * 多线程按层同步BFS(四方向)，求start到全图的步数
+ * 1、已访问为原子位图，不可通行格初始化时即置位；自上而下时fetch_or抢占邻居，只有抢到的线程写距离
+ * 2、自上而下: 当前层列表按块动态分给各线程，新发现的格子写入线程私有的下一层缓冲区，层末拼接
+ * 3、自下而上: 各线程负责一段连续的位图字，未访问格检查四邻是否在当前层位图中，字只有一个写者
+ * 4、方向切换(Beamer): 前沿*ALPHA > 未访问数时转自下而上，前沿*BETA < 总格数时转回自上而下
+ * 5、工作线程在一次run内常驻，每层两次屏障
+ */
+class ParallelBFS {
+public:
+    enum Direction { AUTO, TOP_DOWN, BOTTOM_UP };
+
+    static constexpr long ALPHA = 14;
+    static constexpr long BETA  = 24;
+    static constexpr size_t CHUNK = 256; // 自上而下每次领取的前沿格数
+
+    // threads为0时取硬件并发数
+    explicit ParallelBFS(int threads = 0, Direction direction = AUTO)
+        : thread_cnt{threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency())}
+        , direction{direction} {}
+
+    int threads() const { return thread_cnt; }
+    int top_down_levels() const { return top_down_cnt; }
+    int bottom_up_levels() const { return bottom_up_cnt; }
+
+    // dist[x * cols + y]为步数，不可达为-1；返回最大步数，起点非法返回-1
+    template <typename Grid>
+    int run(const Grid &grid, Point start, std::vector<int> &dist) {
+        rows = grid.rows();
+        cols = grid.cols();
+        cells = (size_t)rows * cols;
+        dist.assign(cells, -1);
+        top_down_cnt = bottom_up_cnt = 0;
+        if (start.first < 0 || start.first >= rows || start.second < 0 || start.second >= cols ||
+            !grid.passable(start.first, start.second))
+            return -1;
+
+        words = (cells + 63) / 64;
+        if (words > bitmap_words) {
+            visited.reset(new std::atomic<uint64_t>[words]);
+            front.reset(new std::atomic<uint64_t>[words]);
+            next.reset(new std::atomic<uint64_t>[words]);
+            bitmap_words = words;
+        }
+        locals.resize(thread_cnt);
+        dist_data = dist.data();
+
+        SpinBarrier barrier(thread_cnt);
+        std::vector<std::thread> workers;
+        for (int t = 1; t < thread_cnt; t++) {
+            workers.emplace_back([this, &grid, &barrier, t]() { work(grid, barrier, t); });
+        }
+        frontier.assign(1, (int)(start.first * cols + start.second));
+        level = 0;
+        work(grid, barrier, 0);
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        return level;
+    }
+
+private:
+    struct alignas(64) Local {
+        std::vector<int> next; // 本线程发现的下一层
+        size_t unvisited = 0;  // 初始化阶段统计的可通行格
+    };
+
+    template <typename Grid>
+    void work(const Grid &grid, SpinBarrier &barrier, int t) {
+        size_t word_lo = words * t / thread_cnt, word_hi = words * (t + 1) / thread_cnt;
+        // 初始化: 本线程负责的字，不可通行及越界位置1
+        size_t open_cnt = 0;
+        for (size_t w = word_lo; w < word_hi; w++) {
+            uint64_t bits = 0;
+            for (int i = 0; i < 64; i++) {
+                size_t idx = w * 64 + i;
+                if (idx >= cells || !grid.passable((int)(idx / cols), (int)(idx % cols))) {
+                    bits |= 1ull << i;
+                } else {
+                    open_cnt++;
+                }
+            }
+            visited[w].store(bits, std::memory_order_relaxed);
+        }
+        locals[t].unvisited = open_cnt;
+        barrier.wait();
+        if (t == 0) {
+            int start_idx = frontier[0];
+            visited[start_idx >> 6].fetch_or(1ull << (start_idx & 63), std::memory_order_relaxed);
+            dist_data[start_idx] = 0;
+            unvisited = 0;
+            for (auto &local : locals) {
+                unvisited += local.unvisited;
+            }
+            unvisited--;
+            bottom_up = direction == BOTTOM_UP;
+            if (bottom_up)
+                load_front();
+        }
+
+        while (true) {
+            barrier.wait();
+            if (frontier.empty())
+                break;
+            if (t == 0)
+                (bottom_up ? bottom_up_cnt : top_down_cnt)++;
+            locals[t].next.clear();
+            if (bottom_up) {
+                bottom_up_step(word_lo, word_hi, locals[t].next);
+            } else {
+                top_down_step(locals[t].next);
+            }
+            barrier.wait();
+            if (t == 0)
+                finish_level();
+        }
+    }
+
+    void top_down_step(std::vector<int> &out) {
+        int next_level = level + 1;
+        size_t total = frontier.size();
+        for (size_t begin = cursor.fetch_add(CHUNK, std::memory_order_relaxed); begin < total;
+             begin = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) {
+            size_t end = std::min(total, begin + CHUNK);
+            for (size_t i = begin; i < end; i++) {
+                int idx = frontier[i];
+                int y = idx % cols;
+                int around[4] = {idx - cols, idx + cols, y > 0 ? idx - 1 : -1, y + 1 < cols ? idx + 1 : -1};
+                for (int next_idx : around) {
+                    if (next_idx < 0 || (size_t)next_idx >= cells)
+                        continue;
+                    std::atomic<uint64_t> &word = visited[next_idx >> 6];
+                    uint64_t bit = 1ull << (next_idx & 63);
+                    if (word.load(std::memory_order_relaxed) & bit)
+                        continue;
+                    if (word.fetch_or(bit, std::memory_order_relaxed) & bit)
+                        continue;
+                    dist_data[next_idx] = next_level;
+                    out.push_back(next_idx);
+                }
+            }
+        }
+    }
+
+    bool in_front(long idx) const {
+        return (front[idx >> 6].load(std::memory_order_relaxed) >> (idx & 63)) & 1;
+    }
+
+    // 本线程的字[word_lo, word_hi)只由本线程读写visited/next
+    void bottom_up_step(size_t word_lo, size_t word_hi, std::vector<int> &out) {
+        int next_level = level + 1;
+        for (size_t w = word_lo; w < word_hi; w++) {
+            uint64_t seen = visited[w].load(std::memory_order_relaxed);
+            uint64_t found = 0;
+            for (uint64_t todo = ~seen; todo != 0; todo &= todo - 1) {
+                int i = __builtin_ctzll(todo);
+                long idx = (long)(w * 64 + i);
+                int y = (int)(idx % cols);
+                if ((idx >= cols && in_front(idx - cols)) || ((size_t)(idx + cols) < cells && in_front(idx + cols)) ||
+                    (y > 0 && in_front(idx - 1)) || (y + 1 < cols && in_front(idx + 1))) {
+                    found |= 1ull << i;
+                    dist_data[idx] = next_level;
+                    out.push_back((int)idx);
+                }
+            }
+            if (found != 0)
+                visited[w].store(seen | found, std::memory_order_relaxed);
+            next[w].store(found, std::memory_order_relaxed);
+        }
+    }
+
+    // 仅线程0执行: 拼接下一层并决定下一层方向
+    void finish_level() {
+        frontier.clear();
+        for (auto &local : locals) {
+            frontier.insert(frontier.end(), local.next.begin(), local.next.end());
+        }
+        cursor.store(0, std::memory_order_relaxed);
+        if (frontier.empty())
+            return;
+        level++;
+        unvisited -= frontier.size();
+        bool want_bottom_up = bottom_up;
+        if (direction == AUTO) {
+            if (!bottom_up && (long)frontier.size() * ALPHA > (long)unvisited) {
+                want_bottom_up = true;
+            } else if (bottom_up && (long)frontier.size() * BETA < (long)cells) {
+                want_bottom_up = false;
+            }
+        }
+        if (want_bottom_up) {
+            if (bottom_up) {
+                front.swap(next);
+            } else {
+                load_front();
+            }
+        }
+        bottom_up = want_bottom_up;
+    }
+
+    // 由前沿列表生成当前层位图
+    void load_front() {
+        for (size_t w = 0; w < words; w++) {
+            front[w].store(0, std::memory_order_relaxed);
+        }
+        for (int idx : frontier) {
+            front[idx >> 6].fetch_or(1ull << (idx & 63), std::memory_order_relaxed);
+        }
+    }
+
+    int thread_cnt;
+    Direction direction;
+    int rows = 0;
+    int cols = 0;
+    size_t cells = 0;
+    size_t words = 0;
+    size_t bitmap_words = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> visited; // 已访问(含不可通行)
+    std::unique_ptr<std::atomic<uint64_t>[]> front;   // 自下而上: 当前层
+    std::unique_ptr<std::atomic<uint64_t>[]> next;    // 自下而上: 下一层
+    std::vector<Local> locals;
+    std::vector<int> frontier; // 当前层列表
+    std::atomic<size_t> cursor{0};
+    int *dist_data = nullptr;
+    int level = 0;
+    size_t unvisited = 0;
+    bool bottom_up = false;
+    int top_down_cnt = 0;
+    int bottom_up_cnt = 0;
+};
+
+/**
+ * 四连通块索引
+ * 1、build: 逐行扫描与上/左格合并(并查集，路径压缩)，再压平使每格直接指向根，查询只比较两个标号
+ * 2、打开格子: 新建并查集节点并与四邻合并
+ * 3、关闭格子: 若四邻中可通行者在外围8格环上连成一段，删除后不会分裂，只摘除该格；
+ *    否则标记为脏，下次查询时整图重建
+ * 4、关闭的格子可能仍是其他格的根，重新打开时分配新节点；节点数超过两倍格子数时重建压缩
+ */
+class ComponentIndex {
+public:
+    template <typename Grid>
+    void build(const Grid &grid) {
+        rows = grid.rows();
+        cols = grid.cols();
+        cells.assign((size_t)rows * cols, 0);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                cells[(size_t)x * cols + y] = grid.passable(x, y) ? 1 : 0;
+            }
+        }
+        rebuild();
+    }
+
+    int components() {
+        refresh();
+        return component_cnt;
+    }
+
+    // 所在连通块的标号(根节点)，不可通行或越界为-1
+    int label(Point p) {
+        refresh();
+        if (!open_at(p.first, p.second))
+            return -1;
+        return find(node_of[p.first * cols + p.second]);
+    }
+
+    bool connected(Point a, Point b) {
+        int la = label(a);
+        return la >= 0 && la == label(b);
+    }
+
+    // 批量查询，out[i]为queries[i]两端是否连通
+    void connected_many(const std::vector<std::pair<Point, Point>> &queries, std::vector<char> &out) {
+        out.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) {
+            out[i] = connected(queries[i].first, queries[i].second) ? 1 : 0;
+        }
+    }
+
+    bool passable(int x, int y) const {
+        return cells[(size_t)x * cols + y] != 0;
+    }
+
+    // 开关格子，增量维护连通块
+    void set_cell(Point p, bool open) {
+        int x = p.first, y = p.second;
+        int idx = x * cols + y;
+        if (cells[idx] == (open ? 1 : 0))
+            return;
+        cells[idx] = open ? 1 : 0;
+        if (dirty)
+            return;
+        if (open) {
+            if (parent.size() >= 2 * cells.size()) {
+                dirty = true;
+                return;
+            }
+            node_of[idx] = (int)parent.size();
+            parent.push_back(node_of[idx]);
+            component_cnt++;
+            for (auto &dir : NEIGHBORS) {
+                int next_x = x + dir[0], next_y = y + dir[1];
+                if (open_at(next_x, next_y) && unite(node_of[idx], node_of[next_x * cols + next_y]))
+                    component_cnt--;
+            }
+            return;
+        }
+        // 关闭: 外围环上包含直邻的可通行段数
+        static const int RING[8][2] = {{-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}};
+        int runs = 0, open_neighbors = 0;
+        bool run_has_direct = false;
+        int first_open = -1;
+        for (int i = 0; i < 8; i++) {
+            if (!open_at(x + RING[i][0], y + RING[i][1])) {
+                first_open = (i + 1) % 8;
+            }
+        }
+        if (first_open < 0) {
+            return; // 四周全通，不会分裂
+        }
+        for (int k = 0; k < 8; k++) {
+            int i = (first_open + k) % 8;
+            bool ring_open = open_at(x + RING[i][0], y + RING[i][1]);
+            if (ring_open) {
+                if (i % 2 == 0) {
+                    run_has_direct = true;
+                    open_neighbors++;
+                }
+            } else {
+                runs += run_has_direct;
+                run_has_direct = false;
+            }
+        }
+        runs += run_has_direct;
+        if (open_neighbors == 0) {
+            component_cnt--;
+        } else if (runs > 1) {
+            dirty = true;
+        }
+    }
+
+private:
+    static constexpr int NEIGHBORS[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+
+    bool open_at(int x, int y) const {
+        return x >= 0 && x < rows && y >= 0 && y < cols && cells[(size_t)x * cols + y];
+    }
+
+    int find(int node) {
+        int root = node;
+        while (parent[root] != root) {
+            root = parent[root];
+        }
+        while (parent[node] != root) {
+            int up = parent[node];
+            parent[node] = root;
+            node = up;
+        }
+        return root;
+    }
+
+    // 小下标为根，返回是否合并了两个不同的块
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (a > b)
+            std::swap(a, b);
+        parent[b] = a;
+        return true;
+    }
+
+    void refresh() {
+        if (dirty)
+            rebuild();
+    }
+
+    // 两遍扫描: 与上/左合并，再压平
+    void rebuild() {
+        size_t total = cells.size();
+        parent.resize(total);
+        node_of.resize(total);
+        component_cnt = 0;
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                int idx = x * cols + y;
+                node_of[idx] = idx;
+                parent[idx] = idx;
+                if (!cells[idx])
+                    continue;
+                component_cnt++;
+                if (x > 0 && cells[idx - cols] && unite(idx, idx - cols))
+                    component_cnt--;
+                if (y > 0 && cells[idx - 1] && unite(idx, idx - 1))
+                    component_cnt--;
+            }
+        }
+        // 根总是块内最小下标，正序一遍即可压平
+        for (size_t idx = 0; idx < total; idx++) {
+            parent[idx] = parent[parent[idx]];
+        }
+        dirty = false;
+    }
+
+    int rows = 0;
+    int cols = 0;
+    std::vector<uint8_t> cells; // 当前可通行状态
+    std::vector<int> node_of;   // 格子 -> 并查集节点
+    std::vector<int> parent;    // 并查集，前rows*cols个节点与格子一一对应
+    int component_cnt = 0;
+    bool dirty = false;
+};
+
+/**
+ * HPA*分层寻路(四方向，每步代价1)
+ * 1、网格按cluster_size划分为簇；相邻簇边界上两侧都可通行的连续段为入口，
+ *    段长<6取中点，否则取两端，每个入口为一对抽象节点，之间代价1
+ * 2、簇内对每个抽象节点做一次受限BFS，得到簇内节点两两距离
+ * 3、查询: 起终点所在簇内BFS接入抽象图，在抽象图上A*，再逐段用簇内BFS还原格子路径；
+ *    同簇先只在簇内找，结果不保证最短(HPA*的近似)
+ * 4、set_cell只标记所在簇，查询前重算脏簇的四条边界及受影响簇的距离表
+ * 5、路径缓存: 键为(起点簇, 终点簇)，值为抽象节点序列；起终点能在簇内到达缓存路线两端时复用，
+ *    路线经过的簇被重算时失效
+ */
+class HierarchicalSearcher {
+public:
+    explicit HierarchicalSearcher(int cluster_size = 16)
+        : size{std::max(2, cluster_size)} {}
+
+    template <typename Grid>
+    void build(const Grid &grid) {
+        rows = grid.rows();
+        cols = grid.cols();
+        cells.assign((size_t)rows * cols, 0);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                cells[(size_t)x * cols + y] = grid.passable(x, y) ? 1 : 0;
+            }
+        }
+        cluster_rows = (rows + size - 1) / size;
+        cluster_cols = (cols + size - 1) / size;
+        clusters.assign((size_t)cluster_rows * cluster_cols, Cluster{});
+        borders.assign(clusters.size() * 2, {});
+        nodes.clear();
+        free_nodes.clear();
+        cache.clear();
+        dirty.clear();
+        for (int c = 0; c < (int)clusters.size(); c++) {
+            compute_border(c, 0);
+            compute_border(c, 1);
+        }
+        for (int c = 0; c < (int)clusters.size(); c++) {
+            compute_cluster(c);
+        }
+    }
+
+    int rows_count() const { return rows; }
+    int cols_count() const { return cols; }
+    bool passable(int x, int y) const { return cells[(size_t)x * cols + y] != 0; }
+
+    // 修改格子，延迟到下次查询时重算
+    void set_cell(Point p, bool open) {
+        int idx = p.first * cols + p.second;
+        if (cells[idx] == (open ? 1 : 0))
+            return;
+        cells[idx] = open ? 1 : 0;
+        int c = cluster_of(p.first, p.second);
+        if (std::find(dirty.begin(), dirty.end(), c) == dirty.end())
+            dirty.push_back(c);
+    }
+
+    // 找到时path为start到goal的格子序列
+    bool find_path(Point start, Point goal, std::vector<Point> &path) {
+        path.clear();
+        refresh();
+        if (!open_at(start.first, start.second) || !open_at(goal.first, goal.second))
+            return false;
+        int start_cell = start.first * cols + start.second, goal_cell = goal.first * cols + goal.second;
+        int cs = cluster_of(start.first, start.second), cg = cluster_of(goal.first, goal.second);
+        if (cs == cg && cluster_path(cs, start_cell, goal_cell, path))
+            return true;
+
+        cluster_bfs(cs, start_cell, start_dist);
+        std::vector<int> from_start = node_dist(cs, start_dist);
+        cluster_bfs(cg, goal_cell, goal_dist);
+        std::vector<int> to_goal = node_dist(cg, goal_dist);
+
+        route.clear();
+        auto key = ((uint64_t)(uint32_t)cs << 32) | (uint32_t)cg;
+        auto it = cache.find(key);
+        if (cs != cg && it != cache.end() && from_start[nodes[it->second.route.front()].slot] >= 0 &&
+            to_goal[nodes[it->second.route.back()].slot] >= 0) {
+            route = it->second.route;
+            cache_hits++;
+        } else if (abstract_search(cs, cg, goal_cell, from_start, to_goal)) {
+            if (cs != cg)
+                remember(key);
+        } else {
+            return false;
+        }
+        refine(start_cell, goal_cell, path);
+        return true;
+    }
+
+    int node_count() const { return (int)(nodes.size() - free_nodes.size()); }
+    int cluster_count() const { return (int)clusters.size(); }
+    int expanded() const { return expanded_cnt; }          // 上次抽象搜索出堆节点数
+    long hits() const { return cache_hits; }               // 路径缓存命中次数
+    long rebuilt_clusters() const { return rebuilt_cnt; }  // 累计重算的簇数
+
+private:
+    struct Node {
+        int cell;
+        int cluster;
+        int partner; // 边界另一侧的节点
+        int slot;    // 在簇节点表中的位置
+    };
+
+    struct Cluster {
+        std::vector<int> nodes; // 抽象节点
+        std::vector<int> dist;  // k*k距离表，-1为簇内不可达
+    };
+
+    struct CacheEntry {
+        std::vector<int> route;    // 抽象节点序列
+        std::vector<int> clusters; // 路线经过的簇
+    };
+
+    struct OpenEntry {
+        int f;
+        int g;
+        int node;
+        bool operator<(const OpenEntry &other) const { return f > other.f || (f == other.f && g < other.g); }
+    };
+
+    int cluster_of(int x, int y) const { return (x / size) * cluster_cols + y / size; }
+
+    bool open_at(int x, int y) const {
+        return x >= 0 && x < rows && y >= 0 && y < cols && cells[(size_t)x * cols + y];
+    }
+
+    int alloc_node(int cell, int cluster) {
+        int id;
+        if (free_nodes.empty()) {
+            id = (int)nodes.size();
+            nodes.push_back({});
+        } else {
+            id = free_nodes.back();
+            free_nodes.pop_back();
+        }
+        nodes[id] = {cell, cluster, -1, -1};
+        return id;
+    }
+
+    // 重算簇c的右边界(side=0)或下边界(side=1)上的入口
+    void compute_border(int c, int side) {
+        auto &border = borders[c * 2 + side];
+        for (int id : border) {
+            free_nodes.push_back(id);
+        }
+        border.clear();
+        int cx = c / cluster_cols, cy = c % cluster_cols;
+        if ((side == 0 && cy + 1 >= cluster_cols) || (side == 1 && cx + 1 >= cluster_rows))
+            return;
+        int other = side == 0 ? c + 1 : c + cluster_cols;
+        int length = side == 0 ? std::min(size, rows - cx * size) : std::min(size, cols - cy * size);
+        // 第i对: 本簇一侧(x, y)与另一侧(x + dx, y + dy)
+        int dx = side, dy = 1 - side;
+        auto cell_at = [&](int i) {
+            return side == 0 ? Point{cx * size + i, cy * size + size - 1} : Point{cx * size + size - 1, cy * size + i};
+        };
+        auto pair_open = [&](int i) {
+            Point p = cell_at(i);
+            return open_at(p.first, p.second) && open_at(p.first + dx, p.second + dy);
+        };
+        for (int i = 0; i < length;) {
+            if (!pair_open(i)) {
+                i++;
+                continue;
+            }
+            int end = i;
+            while (end < length && pair_open(end)) {
+                end++;
+            }
+            int picks[2] = {i + (end - i) / 2, -1};
+            if (end - i >= 6) {
+                picks[0] = i;
+                picks[1] = end - 1;
+            }
+            for (int pick : picks) {
+                if (pick < 0)
+                    continue;
+                Point p = cell_at(pick);
+                int a = alloc_node(p.first * cols + p.second, c);
+                int b = alloc_node((p.first + dx) * cols + p.second + dy, other);
+                nodes[a].partner = b;
+                nodes[b].partner = a;
+                border.push_back(a);
+                border.push_back(b);
+            }
+            i = end;
+        }
+    }
+
+    // 收集簇c四条边界上属于本簇的节点，重算簇内距离表
+    void compute_cluster(int c) {
+        Cluster &cluster = clusters[c];
+        cluster.nodes.clear();
+        int cx = c / cluster_cols, cy = c % cluster_cols;
+        int border_ids[4] = {c * 2, c * 2 + 1, cy > 0 ? (c - 1) * 2 : -1, cx > 0 ? (c - cluster_cols) * 2 + 1 : -1};
+        for (int b : border_ids) {
+            if (b < 0)
+                continue;
+            for (int id : borders[b]) {
+                if (nodes[id].cluster == c) {
+                    nodes[id].slot = (int)cluster.nodes.size();
+                    cluster.nodes.push_back(id);
+                }
+            }
+        }
+        int k = (int)cluster.nodes.size();
+        cluster.dist.assign((size_t)k * k, -1);
+        for (int i = 0; i < k; i++) {
+            cluster_bfs(c, nodes[cluster.nodes[i]].cell, local_dist);
+            auto row = node_dist(c, local_dist);
+            std::copy(row.begin(), row.end(), cluster.dist.begin() + (size_t)i * k);
+        }
+        rebuilt_cnt++;
+    }
+
+    // 簇c的格子范围
+    void bounds(int c, int &x0, int &y0, int &x1, int &y1) const {
+        x0 = c / cluster_cols * size;
+        y0 = c % cluster_cols * size;
+        x1 = std::min(rows, x0 + size);
+        y1 = std::min(cols, y0 + size);
+    }
+
+    // 簇内BFS，dist按簇内局部下标，-1为不可达；parent可选
+    void cluster_bfs(int c, int from, std::vector<int> &dist, std::vector<int> *parent = nullptr) {
+        int x0, y0, x1, y1;
+        bounds(c, x0, y0, x1, y1);
+        int w = y1 - y0;
+        dist.assign((size_t)(x1 - x0) * w, -1);
+        if (parent != nullptr)
+            parent->assign(dist.size(), -1);
+        queue.clear();
+        int local = (from / cols - x0) * w + from % cols - y0;
+        dist[local] = 0;
+        queue.push_back(local);
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+        for (size_t head = 0; head < queue.size(); head++) {
+            int cur = queue[head];
+            int x = cur / w + x0, y = cur % w + y0;
+            for (auto &dir : dirs) {
+                int next_x = x + dir[0], next_y = y + dir[1];
+                if (next_x < x0 || next_x >= x1 || next_y < y0 || next_y >= y1 || !cells[(size_t)next_x * cols + next_y])
+                    continue;
+                int next = (next_x - x0) * w + next_y - y0;
+                if (dist[next] >= 0)
+                    continue;
+                dist[next] = dist[cur] + 1;
+                if (parent != nullptr)
+                    (*parent)[next] = cur;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    // 簇内BFS结果中各抽象节点的距离
+    std::vector<int> node_dist(int c, const std::vector<int> &dist) const {
+        int x0, y0, x1, y1;
+        bounds(c, x0, y0, x1, y1);
+        std::vector<int> out;
+        out.reserve(clusters[c].nodes.size());
+        for (int id : clusters[c].nodes) {
+            int cell = nodes[id].cell;
+            out.push_back(dist[(cell / cols - x0) * (y1 - y0) + cell % cols - y0]);
+        }
+        return out;
+    }
+
+    // 簇内from到to的格子路径追加到path(不含已在path末尾的from)
+    bool cluster_path(int c, int from, int to, std::vector<Point> &path) {
+        int x0, y0, x1, y1;
+        bounds(c, x0, y0, x1, y1);
+        int w = y1 - y0;
+        cluster_bfs(c, from, local_dist, &local_parent);
+        int local = (to / cols - x0) * w + to % cols - y0;
+        if (local_dist[local] < 0)
+            return false;
+        size_t begin = path.size();
+        for (; local != -1; local = local_parent[local]) {
+            path.push_back({local / w + x0, local % w + y0});
+        }
+        std::reverse(path.begin() + begin, path.end());
+        if (begin > 0)
+            path.erase(path.begin() + begin); // 去掉重复的起点
+        return true;
+    }
+
+    int heuristic(int cell, int goal_cell) const {
+        return std::abs(cell / cols - goal_cell / cols) + std::abs(cell % cols - goal_cell % cols);
+    }
+
+    // 抽象图A*，虚拟起点连到起点簇节点，目标簇节点连到虚拟终点(编号为nodes.size())
+    bool abstract_search(int cs, int cg, int goal_cell, const std::vector<int> &from_start,
+                         const std::vector<int> &to_goal) {
+        int goal_node = (int)nodes.size();
+        g_score.assign(nodes.size() + 1, INT32_MAX);
+        came_from.assign(nodes.size() + 1, -1);
+        closed.assign(nodes.size() + 1, 0);
+        open.clear();
+        expanded_cnt = 0;
+        auto h = [&](int id) { return heuristic(nodes[id].cell, goal_cell); };
+        for (size_t i = 0; i < clusters[cs].nodes.size(); i++) {
+            int id = clusters[cs].nodes[i];
+            if (from_start[i] < 0)
+                continue;
+            g_score[id] = from_start[i];
+            open.push_back({from_start[i] + h(id), from_start[i], id});
+            std::push_heap(open.begin(), open.end());
+        }
+        auto relax = [&](int from, int to, int g, int f) {
+            if (g >= g_score[to] || closed[to])
+                return;
+            g_score[to] = g;
+            came_from[to] = from;
+            open.push_back({f, g, to});
+            std::push_heap(open.begin(), open.end());
+        };
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end());
+            OpenEntry cur = open.back();
+            open.pop_back();
+            if (closed[cur.node] || cur.g != g_score[cur.node])
+                continue;
+            closed[cur.node] = 1;
+            expanded_cnt++;
+            if (cur.node == goal_node)
+                break;
+            const Node &node = nodes[cur.node];
+            if (node.cluster == cg && to_goal[node.slot] >= 0)
+                relax(cur.node, goal_node, cur.g + to_goal[node.slot], cur.g + to_goal[node.slot]);
+            int partner = node.partner;
+            relax(cur.node, partner, cur.g + 1, cur.g + 1 + h(partner));
+            const Cluster &cluster = clusters[node.cluster];
+            int k = (int)cluster.nodes.size();
+            for (int j = 0; j < k; j++) {
+                int d = cluster.dist[(size_t)node.slot * k + j];
+                int next = cluster.nodes[j];
+                if (d < 0 || next == cur.node)
+                    continue;
+                relax(cur.node, next, cur.g + d, cur.g + d + h(next));
+            }
+        }
+        if (!closed[goal_node])
+            return false;
+        for (int id = came_from[goal_node]; id != -1; id = came_from[id]) {
+            route.push_back(id);
+        }
+        std::reverse(route.begin(), route.end());
+        return true;
+    }
+
+    // 抽象路线逐段还原为格子路径
+    void refine(int start_cell, int goal_cell, std::vector<Point> &path) {
+        path.push_back({start_cell / cols, start_cell % cols});
+        int cur = start_cell;
+        int cur_cluster = cluster_of(start_cell / cols, start_cell % cols);
+        for (size_t i = 0; i < route.size(); i++) {
+            const Node &node = nodes[route[i]];
+            if (i > 0 && nodes[route[i - 1]].partner == route[i] && node.cluster != cur_cluster) {
+                path.push_back({node.cell / cols, node.cell % cols}); // 跨边界一步
+            } else {
+                cluster_path(node.cluster, cur, node.cell, path);
+            }
+            cur = node.cell;
+            cur_cluster = node.cluster;
+        }
+        cluster_path(cur_cluster, cur, goal_cell, path);
+    }
+
+    void remember(uint64_t key) {
+        CacheEntry entry;
+        entry.route = route;
+        for (int id : route) {
+            if (entry.clusters.empty() || entry.clusters.back() != nodes[id].cluster)
+                entry.clusters.push_back(nodes[id].cluster);
+        }
+        cache[key] = std::move(entry);
+    }
+
+    // 重算脏簇的边界，再重算脏簇及相邻簇的距离表，清除经过这些簇的缓存
+    void refresh() {
+        if (dirty.empty())
+            return;
+        std::vector<char> affected(clusters.size(), 0);
+        for (int c : dirty) {
+            int cx = c / cluster_cols, cy = c % cluster_cols;
+            compute_border(c, 0);
+            compute_border(c, 1);
+            if (cy > 0)
+                compute_border(c - 1, 0);
+            if (cx > 0)
+                compute_border(c - cluster_cols, 1);
+            affected[c] = 1;
+            if (cy > 0)
+                affected[c - 1] = 1;
+            if (cy + 1 < cluster_cols)
+                affected[c + 1] = 1;
+            if (cx > 0)
+                affected[c - cluster_cols] = 1;
+            if (cx + 1 < cluster_rows)
+                affected[c + cluster_cols] = 1;
+        }
+        for (int c = 0; c < (int)clusters.size(); c++) {
+            if (affected[c])
+                compute_cluster(c);
+        }
+        for (auto it = cache.begin(); it != cache.end();) {
+            bool stale = std::any_of(it->second.clusters.begin(), it->second.clusters.end(),
+                                     [&affected](int c) { return affected[c] != 0; });
+            it = stale ? cache.erase(it) : std::next(it);
+        }
+        dirty.clear();
+    }
+
+    int size;
+    int rows = 0;
+    int cols = 0;
+    int cluster_rows = 0;
+    int cluster_cols = 0;
+    std::vector<uint8_t> cells;
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<int>> borders; // 簇c的右边界2c、下边界2c+1上的节点
+    std::vector<Node> nodes;
+    std::vector<int> free_nodes;
+    std::vector<int> dirty;
+    std::unordered_map<uint64_t, CacheEntry> cache;
+    std::vector<int> route;
+    // 查询暂存
+    std::vector<int> start_dist, goal_dist, local_dist, local_parent, queue;
+    std::vector<int> g_score, came_from;
+    std::vector<char> closed;
+    std::vector<OpenEntry> open;
+    int expanded_cnt = 0;
+    long cache_hits = 0;
+    long rebuilt_cnt = 0;
+};
+
+// 代价网格，每格1字节: 0为障碍，1~255为进入该格的代价
+class CostGrid {
+public:
+    CostGrid() = default;
+    CostGrid(int rows, int cols, uint8_t fill = 1)
+        : row_cnt{rows}
+        , col_cnt{cols}
+        , costs((size_t)rows * cols, fill) {}
+
+    // 由vector<vector<int>>构造，超过255的代价截断为255，负数视为障碍
+    static CostGrid from_array(const std::vector<std::vector<int>> &array) {
+        CostGrid grid((int)array.size(), array.empty() ? 0 : (int)array[0].size(), 0);
+        for (int x = 0; x < grid.row_cnt; x++) {
+            for (int y = 0; y < grid.col_cnt; y++) {
+                grid.set(x, y, std::max(0, std::min(255, array[x][y])));
+            }
+        }
+        return grid;
+    }
+
+    int rows() const { return row_cnt; }
+    int cols() const { return col_cnt; }
+    bool passable(int x, int y) const { return costs[(size_t)x * col_cnt + y] != 0; }
+    int cost(int x, int y) const { return costs[(size_t)x * col_cnt + y]; }
+    void set(int x, int y, int cost) { costs[(size_t)x * col_cnt + y] = (uint8_t)cost; }
+
+private:
+    int row_cnt = 0;
+    int col_cnt = 0;
+    std::vector<uint8_t> costs;
+};
+
+// Dial桶队列: 键单调不减且同时在队列中的键跨度不超过MAX_COST，环形MAX_COST+1个桶
+class BucketQueue {
+public:
+    static constexpr int MAX_COST = 255;
+
+    void clear() {
+        for (auto &bucket : buckets) {
+            bucket.clear();
+        }
+        current = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t key, int idx) {
+        buckets[key % (MAX_COST + 1)].push_back(idx);
+        count++;
+    }
+
+    // 弹出键最小的一项
+    void pop(uint32_t &key, int &idx) {
+        while (buckets[current % (MAX_COST + 1)].empty()) {
+            current++;
+        }
+        auto &bucket = buckets[current % (MAX_COST + 1)];
+        key = current;
+        idx = bucket.back();
+        bucket.pop_back();
+        count--;
+    }
+
+private:
+    std::vector<int> buckets[MAX_COST + 1];
+    uint32_t current = 0;
+    size_t count = 0;
+};
+
+// 基数堆: 键单调不减，按与上次弹出键的最高不同位分桶，每项最多下移32次
+class RadixHeap {
+public:
+    void clear() {
+        for (auto &bucket : buckets) {
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t key, int idx) {
+        buckets[bucket_of(key)].push_back({key, idx});
+        count++;
+    }
+
+    void pop(uint32_t &key, int &idx) {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            // 以该桶最小键为新基准，桶内元素全部落入更低的桶
+            last = buckets[i][0].first;
+            for (auto &entry : buckets[i]) {
+                last = std::min(last, entry.first);
+            }
+            for (auto &entry : buckets[i]) {
+                buckets[bucket_of(entry.first)].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+        key = buckets[0].back().first;
+        idx = buckets[0].back().second;
+        buckets[0].pop_back();
+        count--;
+    }
+
+private:
+    int bucket_of(uint32_t key) const {
+        return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+    }
+
+    std::vector<std::pair<uint32_t, int>> buckets[33];
+    uint32_t last = 0;
+    size_t count = 0;
+};
+
+/**
+ * 权值网格最短路(四方向)，Grid需提供rows()/cols()/cost(x, y)，代价为进入目标格的cost，0为障碍
+ * 1、dial: 桶队列，cost需不超过BucketQueue::MAX_COST(调用方保证，超出时结果错误)，每次入队/出队O(1)
+ * 2、radix: 基数堆，cost可为任意正整数
+ * 3、distance_transform: 多源距离场(到最近源点的最小代价)，源点本身为0
+ * 4、距离/父节点数组按代数戳复用，cost()为上次单源查询的路径代价
+ */
+class WeightedSearcher {
+public:
+    template <typename Grid>
+    bool dial(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        return search(grid, start, goal, path, bucket_queue);
+    }
+
+    template <typename Grid>
+    bool radix(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        return search(grid, start, goal, path, radix_heap);
+    }
+
+    // dist[x * cols + y]为到最近源点的代价，不可达为-1
+    template <typename Grid>
+    void distance_transform(const Grid &grid, const std::vector<Point> &sources, std::vector<int> &dist) {
+        int rows = grid.rows(), cols = grid.cols();
+        prepare((size_t)rows * cols);
+        bucket_queue.clear();
+        for (const Point &p : sources) {
+            if (p.first < 0 || p.first >= rows || p.second < 0 || p.second >= cols || !grid.cost(p.first, p.second))
+                continue;
+            int idx = p.first * cols + p.second;
+            if (stamp[idx] == generation)
+                continue;
+            relax(idx, 0, -1);
+            bucket_queue.push(0, idx);
+        }
+        run(grid, -1, bucket_queue);
+        dist.assign((size_t)rows * cols, -1);
+        for (size_t i = 0; i < dist.size(); i++) {
+            if (stamp[i] == generation)
+                dist[i] = (int)g_score[i];
+        }
+    }
+
+    long cost() const { return path_cost; }
+
+private:
+    template <typename Grid, typename Queue>
+    bool search(const Grid &grid, Point start, Point goal, std::vector<Point> &path, Queue &queue) {
+        path.clear();
+        path_cost = -1;
+        int rows = grid.rows(), cols = grid.cols();
+        for (const Point &p : {start, goal}) {
+            if (p.first < 0 || p.first >= rows || p.second < 0 || p.second >= cols || !grid.cost(p.first, p.second))
+                return false;
+        }
+        prepare((size_t)rows * cols);
+        queue.clear();
+        int start_idx = start.first * cols + start.second, goal_idx = goal.first * cols + goal.second;
+        relax(start_idx, 0, -1);
+        queue.push(0, start_idx);
+        run(grid, goal_idx, queue);
+        if (stamp[goal_idx] != generation)
+            return false;
+        path_cost = g_score[goal_idx];
+        for (int idx = goal_idx; idx != -1; idx = parent[idx]) {
+            path.push_back({idx / cols, idx % cols});
+        }
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    // Dijkstra主循环，弹出goal_idx时提前结束(-1为求全图)
+    template <typename Grid, typename Queue>
+    void run(const Grid &grid, int goal_idx, Queue &queue) {
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+        int rows = grid.rows(), cols = grid.cols();
+        while (!queue.empty()) {
+            uint32_t key;
+            int idx;
+            queue.pop(key, idx);
+            if (key != g_score[idx])
+                continue; // 过期项
+            if (idx == goal_idx)
+                return;
+            int x = idx / cols, y = idx % cols;
+            for (auto &dir : dirs) {
+                int next_x = x + dir[0], next_y = y + dir[1];
+                if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols)
+                    continue;
+                int w = grid.cost(next_x, next_y);
+                if (w <= 0)
+                    continue;
+                int next_idx = next_x * cols + next_y;
+                uint32_t next_key = key + (uint32_t)w;
+                if (stamp[next_idx] == generation && g_score[next_idx] <= next_key)
+                    continue;
+                relax(next_idx, next_key, idx);
+                queue.push(next_key, next_idx);
+            }
+        }
+    }
+
+    void prepare(size_t cells) {
+        if (cells > stamp.size()) {
+            stamp.assign(cells, 0);
+            g_score.resize(cells);
+            parent.resize(cells);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    void relax(int idx, uint32_t g, int from) {
+        stamp[idx] = generation;
+        g_score[idx] = g;
+        parent[idx] = from;
+    }
+
+    uint32_t generation = 0;
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> g_score;
+    std::vector<int> parent;
+    BucketQueue bucket_queue;
+    RadixHeap radix_heap;
+    long path_cost = -1;
+};
+
+// 分块网格文件: 文件头 + 块索引 + 块数据；块为tile*tile位，每行tile/64个字，越界位置0
+struct TiledGridHeader {
+    uint32_t magic;     // TILED_GRID_MAGIC
+    uint32_t tile;      // 块边长，64的倍数
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t tile_rows; // 块行数
+    uint64_t tile_cols; // 块列数
+};
+
+struct TileIndex {
+    uint64_t offset;   // 块数据在文件中的偏移，原始块按页对齐
+    uint32_t bytes;    // 块数据字节数
+    uint8_t encoding;  // TileEncoding
+    uint8_t pad[3];
+};
+
+enum TileEncoding : uint8_t {
+    TILE_BLOCKED = 0, // 全部障碍，无数据
+    TILE_OPEN    = 1, // 全部可通行，无数据
+    TILE_RAW     = 2, // 原始位图
+    TILE_RLE     = 3, // 游程编码: 从0开始交替的游程长度，varint
+};
+
+constexpr uint32_t TILED_GRID_MAGIC = 0x44524754; // "TGRD"
+constexpr size_t TILE_PAGE          = 4096;
+
+/**
+ * 分块网格的只读mmap视图，满足Grid接口(rows/cols/passable)
+ * 1、write: 逐块编码写文件，全通/全堵的块只占索引，游程编码更小时存压缩块
+ * 2、open: mmap整个文件，访问时才触发缺页；常驻块数超过cache_tiles时按LRU淘汰，
+ *    原始块madvise(MADV_DONTNEED)归还页面，压缩块解码到槽位缓冲区
+ * 3、最近访问的块单独记住，同一块内连续访问不查缓存
+ * 4、缓存状态在const访问中更新，不能多线程共享同一对象
+ */
+class TiledGrid {
+public:
+    TiledGrid() = default;
+    TiledGrid(const TiledGrid &) = delete;
+    TiledGrid &operator=(const TiledGrid &) = delete;
+
+    ~TiledGrid() {
+        close();
+    }
+
+    // 把任意Grid按tile分块写入文件，compress为false时不做游程编码
+    template <typename Grid>
+    static bool write(const std::string &path, const Grid &grid, int tile = 256, bool compress = true) {
+        if (tile <= 0 || tile % 64 != 0)
+            return false;
+        TiledGridHeader header{TILED_GRID_MAGIC, (uint32_t)tile, (uint64_t)grid.rows(), (uint64_t)grid.cols(),
+                               ((uint64_t)grid.rows() + tile - 1) / tile, ((uint64_t)grid.cols() + tile - 1) / tile};
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        std::vector<TileIndex> index(header.tile_rows * header.tile_cols);
+        uint64_t offset = sizeof(header) + index.size() * sizeof(TileIndex);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(TileIndex));
+
+        size_t words = (size_t)tile * tile / 64;
+        std::vector<uint64_t> bits(words);
+        std::vector<uint8_t> rle;
+        for (uint64_t t = 0; t < index.size(); t++) {
+            int x0 = (int)(t / header.tile_cols) * tile, y0 = (int)(t % header.tile_cols) * tile;
+            size_t open_cnt = 0;
+            std::fill(bits.begin(), bits.end(), 0);
+            for (int lx = 0; lx < tile && x0 + lx < grid.rows(); lx++) {
+                for (int ly = 0; ly < tile && y0 + ly < grid.cols(); ly++) {
+                    if (grid.passable(x0 + lx, y0 + ly)) {
+                        bits[(size_t)lx * (tile / 64) + ly / 64] |= 1ull << (ly & 63);
+                        open_cnt++;
+                    }
+                }
+            }
+            TileIndex &entry = index[t];
+            if (open_cnt == 0 || open_cnt == (size_t)tile * tile) {
+                entry.encoding = open_cnt == 0 ? TILE_BLOCKED : TILE_OPEN;
+                continue;
+            }
+            if (compress)
+                encode_rle(bits, rle);
+            if (compress && rle.size() < words * 8) {
+                entry = {offset, (uint32_t)rle.size(), TILE_RLE, {}};
+                file.write(reinterpret_cast<const char *>(rle.data()), rle.size());
+                offset += rle.size();
+            } else {
+                // 原始块按页对齐，淘汰时可以整页归还
+                uint64_t aligned = (offset + TILE_PAGE - 1) / TILE_PAGE * TILE_PAGE;
+                std::vector<char> pad(aligned - offset, 0);
+                file.write(pad.data(), pad.size());
+                entry = {aligned, (uint32_t)(words * 8), TILE_RAW, {}};
+                file.write(reinterpret_cast<const char *>(bits.data()), words * 8);
+                offset = aligned + words * 8;
+            }
+        }
+        file.seekp(sizeof(header));
+        file.write(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(TileIndex));
+        return file.good();
+    }
+
+    // 打开文件，cache_tiles为最多同时常驻的非均匀块数
+    bool open(const std::string &path, size_t cache_tiles = 64) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TiledGridHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+        map_addr = static_cast<const char *>(addr);
+        map_size = st.st_size;
+        std::memcpy(&header, map_addr, sizeof(header));
+        if (!valid_header()) {
+            close();
+            return false;
+        }
+        size_t tiles = header.tile_rows * header.tile_cols;
+        words_per_row = header.tile / 64;
+        tile_words = (size_t)header.tile * words_per_row;
+        index = reinterpret_cast<const TileIndex *>(map_addr + sizeof(header));
+        // 块数据须在文件内(写成减法避免offset + bytes溢出)，原始块须恰为一整块且按字对齐
+        for (size_t t = 0; t < tiles; t++) {
+            const TileIndex &entry = index[t];
+            bool bad = entry.encoding > TILE_RLE;
+            if (entry.encoding >= TILE_RAW)
+                bad = bad || entry.offset > map_size || entry.bytes > map_size - entry.offset;
+            if (entry.encoding == TILE_RAW)
+                bad = bad || entry.bytes != tile_words * 8 || entry.offset % 8 != 0;
+            if (bad) {
+                close();
+                return false;
+            }
+        }
+        // 行内按字访问，访问模式随机，关闭预读
+        madvise(const_cast<char *>(map_addr), map_size, MADV_RANDOM);
+        all_blocked.assign(tile_words, 0);
+        all_open.assign(tile_words, ~0ull);
+        tile_slot.assign(tiles, -1);
+        slots.assign(std::max<size_t>(1, cache_tiles), Slot{});
+        last_tile = SIZE_MAX;
+        return true;
+    }
+
+    void close() {
+        if (map_addr != nullptr)
+            munmap(const_cast<char *>(map_addr), map_size);
+        map_addr = nullptr;
+        map_size = 0;
+        index = nullptr;
+        header = TiledGridHeader{};
+        slots.clear();
+        tile_slot.clear();
+        last_tile = SIZE_MAX;
+        load_cnt = evict_cnt = 0;
+    }
+
+    int rows() const { return (int)header.rows; }
+    int cols() const { return (int)header.cols; }
+
+    bool passable(int x, int y) const {
+        size_t tile = (size_t)(x / header.tile) * header.tile_cols + y / header.tile;
+        if (tile != last_tile) {
+            last_bits = fetch(tile);
+            last_tile = tile;
+        }
+        int lx = x % header.tile, ly = y % header.tile;
+        return (last_bits[(size_t)lx * words_per_row + (ly >> 6)] >> (ly & 63)) & 1;
+    }
+
+    size_t resident() const {
+        size_t cnt = 0;
+        for (auto &slot : slots) {
+            cnt += slot.tile != SIZE_MAX;
+        }
+        return cnt;
+    }
+    long loads() const { return load_cnt; }      // 块载入次数(缓存未命中)
+    long evictions() const { return evict_cnt; } // 块淘汰次数
+
+private:
+    struct Slot {
+        size_t tile = SIZE_MAX;
+        uint64_t last_use = 0;
+        const uint64_t *data = nullptr;
+        std::vector<uint64_t> decoded; // 压缩块解码缓冲区
+    };
+
+    static void put_varint(std::vector<uint8_t> &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    static void encode_rle(const std::vector<uint64_t> &bits, std::vector<uint8_t> &out) {
+        out.clear();
+        size_t total = bits.size() * 64;
+        uint64_t bit = 0, run = 0;
+        for (size_t i = 0; i < total; i++) {
+            uint64_t value = (bits[i >> 6] >> (i & 63)) & 1;
+            if (value != bit) {
+                put_varint(out, run);
+                bit = value;
+                run = 0;
+            }
+            run++;
+        }
+        put_varint(out, run);
+    }
+
+    static void decode_rle(const uint8_t *data, size_t bytes, std::vector<uint64_t> &bits) {
+        std::fill(bits.begin(), bits.end(), 0);
+        size_t pos = 0, limit = bits.size() * 64;
+        uint64_t bit = 0;
+        for (size_t i = 0; i < bytes && pos < limit; bit ^= 1) {
+            uint64_t run = 0;
+            for (int shift = 0; i < bytes; shift += 7) {
+                uint8_t byte = data[i++];
+                run |= (uint64_t)(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    break;
+            }
+            if (bit) {
+                for (size_t k = pos; k < std::min(limit, pos + run); k++) {
+                    bits[k >> 6] |= 1ull << (k & 63);
+                }
+            }
+            pos += run;
+        }
+    }
+
+    // 文件头校验: 块边长合法，块数不溢出且索引在文件内，块网格覆盖rows*cols，行列数可用int表示
+    bool valid_header() const {
+        if (header.magic != TILED_GRID_MAGIC || header.tile == 0 || header.tile % 64 != 0)
+            return false;
+        if (header.rows > INT_MAX || header.cols > INT_MAX)
+            return false;
+        if (header.tile_rows != 0 && header.tile_cols > SIZE_MAX / sizeof(TileIndex) / header.tile_rows)
+            return false;
+        size_t tiles = header.tile_rows * header.tile_cols;
+        if (tiles * sizeof(TileIndex) > map_size - sizeof(header))
+            return false;
+        return (header.rows + header.tile - 1) / header.tile <= header.tile_rows &&
+               (header.cols + header.tile - 1) / header.tile <= header.tile_cols;
+    }
+
+    const uint64_t *fetch(size_t tile) const {
+        const TileIndex &entry = index[tile];
+        if (entry.encoding == TILE_BLOCKED)
+            return all_blocked.data();
+        if (entry.encoding == TILE_OPEN)
+            return all_open.data();
+        int slot_id = tile_slot[tile];
+        if (slot_id >= 0) {
+            slots[slot_id].last_use = ++clock;
+            return slots[slot_id].data;
+        }
+        // 未命中: 取空槽或最久未用的槽
+        slot_id = 0;
+        for (int i = 0; i < (int)slots.size(); i++) {
+            if (slots[i].tile == SIZE_MAX) {
+                slot_id = i;
+                break;
+            }
+            if (slots[i].last_use < slots[slot_id].last_use)
+                slot_id = i;
+        }
+        Slot &slot = slots[slot_id];
+        if (slot.tile != SIZE_MAX) {
+            const TileIndex &old = index[slot.tile];
+            if (old.encoding == TILE_RAW)
+                madvise(const_cast<char *>(map_addr) + old.offset, old.bytes, MADV_DONTNEED);
+            tile_slot[slot.tile] = -1;
+            evict_cnt++;
+        }
+        const char *data = map_addr + entry.offset;
+        if (entry.encoding == TILE_RAW) {
+            slot.data = reinterpret_cast<const uint64_t *>(data);
+        } else {
+            slot.decoded.resize(tile_words);
+            decode_rle(reinterpret_cast<const uint8_t *>(data), entry.bytes, slot.decoded);
+            slot.data = slot.decoded.data();
+        }
+        slot.tile = tile;
+        slot.last_use = ++clock;
+        tile_slot[tile] = slot_id;
+        load_cnt++;
+        return slot.data;
+    }
+
+    const char *map_addr = nullptr;
+    size_t map_size = 0;
+    TiledGridHeader header{};
+    const TileIndex *index = nullptr;
+    int words_per_row = 0;
+    size_t tile_words = 0;
+    std::vector<uint64_t> all_blocked;
+    std::vector<uint64_t> all_open;
+    mutable std::vector<int> tile_slot; // 块 -> 槽位，-1为不在缓存
+    mutable std::vector<Slot> slots;
+    mutable uint64_t clock = 0;
+    mutable size_t last_tile = SIZE_MAX;
+    mutable const uint64_t *last_bits = nullptr;
+    mutable long load_cnt = 0;
+    mutable long evict_cnt = 0;
+};
+
+/**
+ * 稀疏暂存的网格搜索(四方向)，已访问状态放在哈希表里，内存与搜索到的格子数成正比，
+ * 网格可以大于内存(配合TiledGrid)；下标为64位，不受rows*cols溢出限制
+ */
+class SparseSearcher {
+public:
+    template <typename Grid>
+    bool astar(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        return search(grid, start, goal, path, true);
+    }
+
+    template <typename Grid>
+    bool bfs(const Grid &grid, Point start, Point goal, std::vector<Point> &path) {
+        return search(grid, start, goal, path, false);
+    }
+
+    size_t visited() const { return info.size(); }
+
+private:
+    struct Info {
+        uint64_t parent;
+        int g;
+        bool closed;
+    };
+
+    static uint64_t key(int x, int y) { return (uint64_t)(uint32_t)x << 32 | (uint32_t)y; }
+
+    // heuristic为false时启发值取0，单位代价下按层出队即BFS
+    template <typename Grid>
+    bool search(const Grid &grid, Point start, Point goal, std::vector<Point> &path, bool heuristic) {
+        path.clear();
+        info.clear();
+        for (const Point &p : {start, goal}) {
+            if (p.first < 0 || p.first >= grid.rows() || p.second < 0 || p.second >= grid.cols() ||
+                !grid.passable(p.first, p.second))
+                return false;
+        }
+        auto h = [&](int x, int y) {
+            return heuristic ? std::abs(x - goal.first) + std::abs(y - goal.second) : 0;
+        };
+        using Entry = std::pair<int, uint64_t>; // (f, key)
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        std::queue<uint64_t> fifo;
+        uint64_t start_key = key(start.first, start.second), goal_key = key(goal.first, goal.second);
+        info[start_key] = {UINT64_MAX, 0, false};
+        if (heuristic) {
+            open.push({h(start.first, start.second), start_key});
+        } else {
+            fifo.push(start_key);
+        }
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+        while (heuristic ? !open.empty() : !fifo.empty()) {
+            uint64_t cur;
+            if (heuristic) {
+                cur = open.top().second;
+                open.pop();
+            } else {
+                cur = fifo.front();
+                fifo.pop();
+            }
+            Info &cur_info = info[cur];
+            if (cur_info.closed)
+                continue;
+            cur_info.closed = true;
+            if (cur == goal_key)
+                break;
+            int x = (int)(cur >> 32), y = (int)(uint32_t)cur, g = cur_info.g;
+            for (auto &dir : dirs) {
+                int next_x = x + dir[0], next_y = y + dir[1];
+                if (next_x < 0 || next_x >= grid.rows() || next_y < 0 || next_y >= grid.cols() ||
+                    !grid.passable(next_x, next_y))
+                    continue;
+                uint64_t next_key = key(next_x, next_y);
+                auto it = info.find(next_key);
+                if (it != info.end() && (it->second.closed || it->second.g <= g + 1))
+                    continue;
+                info[next_key] = {cur, g + 1, false};
+                if (heuristic) {
+                    open.push({g + 1 + h(next_x, next_y), next_key});
+                } else {
+                    fifo.push(next_key);
+                }
+            }
+        }
+        auto it = info.find(goal_key);
+        if (it == info.end() || !it->second.closed)
+            return false;
+        for (uint64_t k = goal_key; k != UINT64_MAX; k = info[k].parent) {
+            path.push_back({(int)(k >> 32), (int)(uint32_t)k});
+        }
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    std::unordered_map<uint64_t, Info> info;
+};
+
+} // namespace my_search
+
+class MySearch {
+    using vector2 = std::vector<std::vector<int>>;
+
+private:
+    int m, n;
+    vector2 judge; // BFS_search访问标记
+    std::vector<std::pair<int, int>> path;
+    std::vector<std::vector<int>> array;
+    my_search::GridSearcher searcher;
+    my_search::FrontierBFS frontier_bfs;
+    my_search::ParallelBFS parallel_bfs;
+    my_search::ComponentIndex components;
+    my_search::HierarchicalSearcher hpa;
+    my_search::WeightedSearcher weighted;
+
+public:
+    void init_search() {
+        judge.clear();
+        path.clear();
+        array.clear();
+    }
+
+    // 深度搜素，用于查找是否联通等；显式栈迭代，大网格不会栈溢出
+    bool DFS_search(const vector2 &array) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        bool find_flag = searcher.dfs(my_search::VectorGrid(array), {0, 0}, {n - 1, m - 1}, path);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 只判断左上与右下是否连通，不输出路径
+    bool DFS_connected(const vector2 &array) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        return searcher.connected(my_search::VectorGrid(array), {0, 0}, {n - 1, m - 1});
+    }
+
+    // 深度搜素(位图网格)
+    bool DFS_search(const my_search::BitGrid &grid) {
+        if ((n = grid.rows()) == 0 || (m = grid.cols()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        bool find_flag = searcher.dfs(grid, {0, 0}, {n - 1, m - 1}, path);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 广度搜素，用于查找最优解，按父节点回溯输出最短路径
+    bool BFS_search(const vector2 &array) {
+        bool find_flag = false;
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+
+        judge = std::vector<std::vector<int>>(n, std::vector<int>(m, 0));
+        std::vector<int> parent(n * m, -1);
+        std::queue<std::pair<int, int>> q;
+        path.clear();
+
+        // 添加起点进入队列
+        if (array[0][0] == 0)
+            return false;
+        q.push({0, 0});
+        judge[0][0] = 1;
+
+        // 方向数组，表示相邻的四个方向（上下左右）
+        int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+
+        while (!q.empty()) {
+            auto p = q.front();
+            q.pop();
+            int x = p.first, y = p.second;
+
+            // 如果到达终点
+            if (x == n - 1 && y == m - 1) {
+                find_flag = true;
+                break;
+            }
+
+            // 探索相邻节点
+            for (auto &dir : dirs) {
+                int next_x = x + dir[0];
+                int next_y = y + dir[1];
+
+                // 检查新位置是否可访问并且未被访问过
+                if (next_x >= 0 && next_x < n && next_y >= 0 && next_y < m && array[next_x][next_y] == 1 &&
+                    judge[next_x][next_y] == 0) {
+                    q.push({next_x, next_y});
+                    judge[next_x][next_y] = 1;
+                    parent[next_x * m + next_y] = x * m + y;
+                }
+            }
+        }
+        if (find_flag) {
+            for (int idx = (n - 1) * m + (m - 1); idx != -1; idx = parent[idx]) {
+                path.push_back({idx / m, idx % m});
+            }
+            std::reverse(path.begin(), path.end());
+        }
+        print_path(path);
+        return find_flag;
+    }
+
+    // 广度搜素(位图网格)，整层扩展求步数，再沿步数递减回溯路径
+    bool BFS_search(const my_search::BitGrid &grid) {
+        if ((n = grid.rows()) == 0 || (m = grid.cols()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        std::vector<int> dist;
+        path.clear();
+        int steps = frontier_bfs.run(grid, {0, 0}, {n - 1, m - 1}, &dist);
+        if (steps >= 0) {
+            int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+            path.resize(steps + 1);
+            int x = n - 1, y = m - 1;
+            for (int step = steps; step >= 0; step--) {
+                path[step] = {x, y};
+                for (auto &dir : dirs) {
+                    int prev_x = x + dir[0], prev_y = y + dir[1];
+                    if (prev_x >= 0 && prev_x < n && prev_y >= 0 && prev_y < m &&
+                        dist[prev_x * m + prev_y] == step - 1) {
+                        x = prev_x;
+                        y = prev_y;
+                        break;
+                    }
+                }
+            }
+        }
+        print_path(path);
+        return steps >= 0;
+    }
+
+    // A*搜索左上到右下的最短路径，diagonal为true时八方向
+    bool AStar_search(const vector2 &array, bool diagonal = false) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        bool find_flag = searcher.astar(my_search::VectorGrid(array), {0, 0}, {n - 1, m - 1}, path, diagonal);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 双向广度搜索左上到右下的最短路径
+    bool BiBFS_search(const vector2 &array) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        bool find_flag = searcher.bidirectional_bfs(my_search::VectorGrid(array), {0, 0}, {n - 1, m - 1}, path);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 批量连通查询: 先O(格子数)标号，每个查询O(1)；返回连通的查询个数
+    int connected_many(const vector2 &array, const std::vector<std::pair<my_search::Point, my_search::Point>> &queries,
+                       std::vector<char> &out) {
+        components.build(my_search::VectorGrid(array));
+        components.connected_many(queries, out);
+        return (int)std::count(out.begin(), out.end(), 1);
+    }
+
+    // 多线程求左上角到全图的步数(dist按行展开，不可达为-1)，返回右下角是否可达
+    bool BFS_parallel(const vector2 &array, std::vector<int> &dist) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        parallel_bfs.run(my_search::VectorGrid(array), {0, 0}, dist);
+        return dist[(size_t)n * m - 1] >= 0;
+    }
+
+    // 权值网格左上到右下的最小代价路径，格子值为进入代价: 0为障碍，正数为代价，负数为非法输入
+    // 代价均不超过BucketQueue::MAX_COST(255)时用桶队列，否则用基数堆
+    bool Dijkstra_search(const vector2 &array) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        int max_cost = 0;
+        for (auto &row : array) {
+            for (int value : row) {
+                if (value < 0) {
+                    std::cout << "输入矩阵含负代价\n";
+                    return false;
+                }
+                max_cost = std::max(max_cost, value);
+            }
+        }
+        my_search::VectorGrid grid(array);
+        bool find_flag = max_cost <= my_search::BucketQueue::MAX_COST
+                             ? weighted.dial(grid, {0, 0}, {n - 1, m - 1}, path)
+                             : weighted.radix(grid, {0, 0}, {n - 1, m - 1}, path);
+        if (find_flag)
+            std::cout << "路径代价: " << weighted.cost() << std::endl;
+        print_path(path);
+        return find_flag;
+    }
+
+    // 在分块网格文件上A*搜索，cache_tiles限制常驻块数，地图可大于内存
+    bool Tiled_search(const std::string &file, my_search::Point start, my_search::Point goal,
+                      size_t cache_tiles = 64) {
+        my_search::TiledGrid grid;
+        if (!grid.open(file, cache_tiles)) {
+            std::cout << "打开分块网格文件失败\n";
+            return false;
+        }
+        my_search::SparseSearcher sparse;
+        bool find_flag = sparse.astar(grid, start, goal, path);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 分层寻路: 先载入地图，之后可多次修改格子与查询，只重算受影响的簇
+    void HPA_load(const vector2 &array, int cluster_size = 16) {
+        hpa = my_search::HierarchicalSearcher(cluster_size);
+        hpa.build(my_search::VectorGrid(array));
+    }
+
+    void HPA_update(my_search::Point p, bool open) {
+        hpa.set_cell(p, open);
+    }
+
+    bool HPA_search(my_search::Point start, my_search::Point goal) {
+        bool find_flag = hpa.find_path(start, goal, path);
+        print_path(path);
+        return find_flag;
+    }
+
+    // 跳点搜索左上到右下的八方向最短路径；table非空时为JPS+，需由同一地图build或load
+    bool JPS_search(const vector2 &array, const my_search::JumpTable *table = nullptr) {
+        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
+            std::cout << "输入矩阵尺寸错误\n";
+            return false;
+        }
+        bool find_flag = searcher.jps(my_search::VectorGrid(array), {0, 0}, {n - 1, m - 1}, path, table);
+        print_path(path);
+        return find_flag;
+    }
+
+    bool print_path(const std::vector<std::pair<int, int>> &path) {
+        if (path.size() == 0) {
+            std::cout << "没有找到路径" << std::endl;
+            return false;
+        } else {
+            std::cout << "发现路径:\n";
+            for (const auto &p : path) {
+                std::cout << '(' << p.first << ',' << p.second << ") -> ";
+            }
+            std::cout << "END" << std::endl;
+            return true;
+        }
+    }
+
+    int get_rand_num(int start = 0, int end = 2) {
+        int t = rand() % (end - start) + start;
+        return t;
+    }
+
+    std::vector<std::vector<int>> genrate_rand_array(int n = 0, int m = 0) {
+        // 使用当前时间作为随机数生成器的种子
+        srand((unsigned)time(NULL));
+
+        n = (n == 0) ? get_rand_num(1, 20) : n;
+        m = (m == 0) ? get_rand_num(1, 20) : m;
+        std::cout << "n: " << n << " m: " << m << std::endl;
+        array.resize(n);
+        std::cout << "{\n";
+        for (int i = 0; i < n; i++) {
+            std::cout << "  { ";
+            array[i].reserve(m);
+            for (int j = 0; j < m; j++) {
+                array[i].push_back(get_rand_num());
+                std::cout << array[i].back();
+                if (j != m - 1)
+                    std::cout << ", ";
+                else
+                    std::cout << " ";
+            }
+            std::cout << "}" << std::endl;
+        }
+        std::cout << "}" << std::endl;
+        return array;
+    }
+};
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef _MY_SKIP_LIST_H__
+#define _MY_SKIP_LIST_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "alg_epoch.h"
+
+/**
+ * 并发跳表，按key有序存储 key+data
+ * 1、懒惰跳表: 查找不加锁，插入/删除只锁住各层前驱节点
+ * 2、删除先标记(marked)再摘链，插入全部层链接完成后才置fully_linked
+ * 3、塔高按1/4概率几何分布，塔(各层next指针)与节点在同一块内存中
+ * 4、摘除的节点交给纪元回收
+ */
+namespace my_list {
+using SKIP_KEY_TYPE = long;
+
+// 自旋锁，节点锁只在很短的链接阶段持有
+class SpinLock {
+public:
+    void lock() {
+        while (flag.exchange(true, std::memory_order_acquire)) {
+            while (flag.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() {
+        flag.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+template <typename T>
+struct SkipNode {
+    SKIP_KEY_TYPE key;              // 键值
+    int top_level;                  // 塔高
+    std::atomic<bool> marked;       // 已逻辑删除
+    std::atomic<bool> fully_linked; // 各层均已链接
+    SpinLock lock;
+    alignas(T) unsigned char storage[sizeof(T)];
+    std::atomic<SkipNode *> next[1]; // 塔，实际长度为top_level
+
+    T &data() {
+        return *reinterpret_cast<T *>(storage);
+    }
+    const T &data() const {
+        return *reinterpret_cast<const T *>(storage);
+    }
+
+    // 按塔高分配节点，data由调用者构造
+    static SkipNode *create(SKIP_KEY_TYPE key, int level) {
+        size_t size = offsetof(SkipNode, next) + sizeof(std::atomic<SkipNode *>) * level;
+        void *mem = ::operator new(size);
+        SkipNode *node = static_cast<SkipNode *>(mem);
+        node->key = key;
+        node->top_level = level;
+        new (&node->marked) std::atomic<bool>(false);
+        new (&node->fully_linked) std::atomic<bool>(false);
+        new (&node->lock) SpinLock();
+        for (int i = 0; i < level; i++) {
+            new (&node->next[i]) std::atomic<SkipNode *>(nullptr);
+        }
+        return node;
+    }
+
+    static void destroy(SkipNode *node, bool has_data) {
+        if (has_data) {
+            node->data().~T();
+        }
+        ::operator delete(node);
+    }
+
+    // 供纪元回收调用
+    static void retire_deleter(void *p) {
+        destroy(static_cast<SkipNode *>(p), true);
+    }
+};
+
+template <typename T>
+class skip_list {
+public:
+    using node_type = SkipNode<T>;
+    static constexpr int MAX_LEVEL = 16;
+
+    // 只读游标，持有纪元守卫，存活期间访问到的节点不会被释放
+    class iterator {
+    public:
+        iterator(node_type *n, SKIP_KEY_TYPE h, bool bounded)
+            : node{n}
+            , hi{h}
+            , has_hi{bounded} {
+            skip_invalid();
+        }
+
+        const node_type &operator*() const {
+            return *node;
+        }
+        const node_type *operator->() const {
+            return node;
+        }
+        SKIP_KEY_TYPE key() const {
+            return node->key;
+        }
+        const T &value() const {
+            return node->data();
+        }
+
+        iterator &operator++() {
+            node = node->next[0].load(std::memory_order_acquire);
+            skip_invalid();
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return node == other.node;
+        }
+        bool operator!=(const iterator &other) const {
+            return node != other.node;
+        }
+
+    private:
+        // 跳过未完成插入或已删除的节点，超出上界即结束
+        void skip_invalid() {
+            while (node && (!node->fully_linked.load(std::memory_order_acquire) ||
+                            node->marked.load(std::memory_order_acquire))) {
+                node = node->next[0].load(std::memory_order_acquire);
+            }
+            if (node && has_hi && node->key > hi) {
+                node = nullptr;
+            }
+        }
+
+        node_type *node;
+        SKIP_KEY_TYPE hi;
+        bool has_hi;
+    };
+
+    // 区间[lo, hi]，可用于范围for
+    class range_cursor {
+    public:
+        range_cursor(my_epoch::EpochDomain &d, SKIP_KEY_TYPE h, bool bounded)
+            : guard{d}
+            , start{nullptr}
+            , hi{h}
+            , has_hi{bounded} {}
+
+        iterator begin() const {
+            return iterator(start, hi, has_hi);
+        }
+        iterator end() const {
+            return iterator(nullptr, hi, has_hi);
+        }
+
+    private:
+        friend class skip_list;
+        my_epoch::EpochGuard guard;
+        node_type *start; // 进入临界区后再定位
+        SKIP_KEY_TYPE hi;
+        bool has_hi;
+    };
+
+    explicit skip_list(bool log = false)
+        : list_cur_size{0}
+        , log_switch{log} {
+        head = node_type::create(0, MAX_LEVEL);
+        head->fully_linked.store(true, std::memory_order_relaxed);
+    }
+
+    ~skip_list() {
+        // 析构时不应再有并发访问
+        node_type *node = head->next[0].load(std::memory_order_relaxed);
+        while (node) {
+            node_type *next = node->next[0].load(std::memory_order_relaxed);
+            node_type::destroy(node, true);
+            node = next;
+        }
+        node_type::destroy(head, false);
+    }
+
+    skip_list(const skip_list &) = delete;
+    skip_list &operator=(const skip_list &) = delete;
+
+    // 插入，key已存在返回false
+    template <typename... Args>
+    int insert(SKIP_KEY_TYPE key, Args &&...args) {
+        my_epoch::EpochGuard guard(epoch);
+        int top_level = random_level();
+        node_type *preds[MAX_LEVEL];
+        node_type *succs[MAX_LEVEL];
+        while (true) {
+            int found = find_node(key, preds, succs);
+            if (found != -1) {
+                node_type *node = succs[found];
+                if (!node->marked.load(std::memory_order_acquire)) {
+                    // 等待并发插入完成，保证返回后可见
+                    while (!node->fully_linked.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    print_tip("insert failed key is exist!:", key);
+                    return false;
+                }
+                // 正在被删除，重试
+                continue;
+            }
+
+            int locked = -1;
+            if (!lock_preds(preds, succs, top_level, nullptr, locked)) {
+                unlock_preds(preds, locked);
+                continue;
+            }
+
+            node_type *node = node_type::create(key, top_level);
+            new (node->storage) T(std::forward<Args>(args)...);
+            for (int level = 0; level < top_level; level++) {
+                node->next[level].store(succs[level], std::memory_order_relaxed);
+            }
+            for (int level = 0; level < top_level; level++) {
+                preds[level]->next[level].store(node, std::memory_order_release);
+            }
+            node->fully_linked.store(true, std::memory_order_release);
+            unlock_preds(preds, locked);
+            list_cur_size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // 删除，key不存在返回false
+    int erase(SKIP_KEY_TYPE key) {
+        my_epoch::EpochGuard guard(epoch);
+        node_type *victim = nullptr;
+        bool is_marked = false;
+        int top_level = -1;
+        node_type *preds[MAX_LEVEL];
+        node_type *succs[MAX_LEVEL];
+        while (true) {
+            int found = find_node(key, preds, succs);
+            if (!is_marked && !(found != -1 && ok_to_delete(succs[found], found))) {
+                print_tip("key no exsit!:", key);
+                return false;
+            }
+
+            if (!is_marked) {
+                // 标记为逻辑删除，此后只有本线程会摘链
+                victim = succs[found];
+                top_level = victim->top_level;
+                victim->lock.lock();
+                if (victim->marked.load(std::memory_order_relaxed)) {
+                    victim->lock.unlock();
+                    return false;
+                }
+                victim->marked.store(true, std::memory_order_release);
+                is_marked = true;
+            }
+
+            int locked = -1;
+            if (!lock_preds(preds, succs, top_level, victim, locked)) {
+                unlock_preds(preds, locked);
+                continue;
+            }
+
+            for (int level = top_level - 1; level >= 0; level--) {
+                preds[level]->next[level].store(victim->next[level].load(std::memory_order_relaxed),
+                                                std::memory_order_release);
+            }
+            victim->lock.unlock();
+            unlock_preds(preds, locked);
+            list_cur_size.fetch_sub(1, std::memory_order_relaxed);
+            epoch.retire(victim, &node_type::retire_deleter);
+            return true;
+        }
+    }
+
+    // 查找并获取元素，不加锁
+    int find(SKIP_KEY_TYPE key, T &data) {
+        my_epoch::EpochGuard guard(epoch);
+        node_type *node = lower_bound_node(key);
+        if (node && node->key == key && node->fully_linked.load(std::memory_order_acquire) &&
+            !node->marked.load(std::memory_order_acquire)) {
+            data = node->data();
+            return true;
+        }
+        print_tip(" key is no exist!:", key);
+        return false;
+    }
+
+    // 是否存在
+    bool contains(SKIP_KEY_TYPE key) {
+        my_epoch::EpochGuard guard(epoch);
+        node_type *node = lower_bound_node(key);
+        return node && node->key == key && node->fully_linked.load(std::memory_order_acquire) &&
+               !node->marked.load(std::memory_order_acquire);
+    }
+
+    // 全部元素，按key升序
+    range_cursor all() {
+        range_cursor cursor(epoch, 0, false);
+        cursor.start = head->next[0].load(std::memory_order_acquire);
+        return cursor;
+    }
+
+    // 区间[lo, hi]内的元素，按key升序
+    range_cursor range(SKIP_KEY_TYPE lo, SKIP_KEY_TYPE hi) {
+        range_cursor cursor(epoch, hi, true);
+        cursor.start = lower_bound_node(lo);
+        return cursor;
+    }
+
+    // 获取大小
+    int get_list_size() {
+        return list_cur_size.load(std::memory_order_relaxed);
+    }
+
+    void print_list(std::string title) {
+        std::cout << title << ":size:" << get_list_size() << std::endl;
+        for (auto &node : all()) {
+            std::cout << "element:" << node.key << "," << node.data() << std::endl;
+        }
+    }
+
+private:
+    // 各层查找前驱与后继，返回key所在的最高层，未找到返回-1
+    int find_node(SKIP_KEY_TYPE key, node_type **preds, node_type **succs) {
+        int found = -1;
+        node_type *pred = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+            node_type *curr = pred->next[level].load(std::memory_order_acquire);
+            while (curr && curr->key < key) {
+                pred = curr;
+                curr = pred->next[level].load(std::memory_order_acquire);
+            }
+            if (found == -1 && curr && curr->key == key) {
+                found = level;
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return found;
+    }
+
+    // 第一个key >= 给定值的节点
+    node_type *lower_bound_node(SKIP_KEY_TYPE key) {
+        node_type *pred = head;
+        node_type *curr = nullptr;
+        for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+            curr = pred->next[level].load(std::memory_order_acquire);
+            while (curr && curr->key < key) {
+                pred = curr;
+                curr = pred->next[level].load(std::memory_order_acquire);
+            }
+        }
+        return curr;
+    }
+
+    bool ok_to_delete(node_type *node, int found) {
+        return node->fully_linked.load(std::memory_order_acquire) && node->top_level - 1 == found &&
+               !node->marked.load(std::memory_order_acquire);
+    }
+
+    // 自底向上锁住前驱并校验，locked返回已加锁的最高层
+    // 插入时victim为空，校验后继未被删除；删除时校验前驱仍指向victim
+    bool lock_preds(node_type **preds, node_type **succs, int top_level, node_type *victim, int &locked) {
+        node_type *prev_pred = nullptr;
+        for (int level = 0; level < top_level; level++) {
+            node_type *pred = preds[level];
+            node_type *succ = succs[level];
+            if (pred != prev_pred) {
+                pred->lock.lock();
+                prev_pred = pred;
+            }
+            locked = level;
+            bool valid = !pred->marked.load(std::memory_order_acquire);
+            if (victim) {
+                valid = valid && pred->next[level].load(std::memory_order_acquire) == victim;
+            } else {
+                valid = valid && (succ == nullptr || !succ->marked.load(std::memory_order_acquire)) &&
+                        pred->next[level].load(std::memory_order_acquire) == succ;
+            }
+            if (!valid) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unlock_preds(node_type **preds, int locked) {
+        node_type *prev_pred = nullptr;
+        for (int level = 0; level <= locked; level++) {
+            if (preds[level] != prev_pred) {
+                preds[level]->lock.unlock();
+                prev_pred = preds[level];
+            }
+        }
+    }
+
+    // 几何分布塔高，p=1/4
+    static int random_level() {
+        thread_local uint64_t seed = 0x9E3779B97F4A7C15ull ^ (uint64_t)(uintptr_t)&seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int level = 1;
+        uint64_t bits = seed;
+        while (level < MAX_LEVEL && (bits & 3) == 0) {
+            level++;
+            bits >>= 2;
+        }
+        return level;
+    }
+
+    // 打印提示
+    template <typename... Args> void print_tip(const Args &...args) {
+        if (log_switch) {
+            std::cout << "Info: ";
+            ((std::cout << args), ...);
+            std::cout << std::endl;
+        }
+    }
+
+private:
+    node_type *head; // 哨兵，塔高MAX_LEVEL
+    std::atomic<int> list_cur_size;
+    bool log_switch; // log 打印开关
+    my_epoch::EpochDomain epoch;
+};
+
+} // namespace my_list
+
+#endif
@@ -1,70 +1,164 @@
 #ifndef _MY_TREE_H__
 #define _MY_TREE_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <thread>
+#include <type_traits>
+#include <unistd.h>
 #include <utility>
+#include <vector>
 
 /**
- * 1、平衡二叉树
+ * 1、平衡二叉树: 节点维护子树大小与可选的幺半群聚合值，支持O(log n)的排名/选择/区间统计
+ *    基于join/split的O(n)有序构建、批量插入与并/交/差，大子树分叉到std::async并行
+ * 2、平衡二叉树(arena版): 节点连续存放，子节点用32位下标，迭代插入删除
+ * 3、持久化平衡二叉树: 路径复制，未修改子树由shared_ptr共享，读者原子取根即得一致快照
+ * 4、平铺只读树: AVLTree::freeze()导出无指针的Eytzinger布局，可写文件后由多进程mmap直接查询
  */
 namespace my_tree {
+// 平铺树格式: 文件头 + 从FLAT_DATA_OFFSET开始的(count+1)个元素，下标0空置，k的子节点为2k与2k+1
+struct FlatTreeHeader {
+    uint32_t magic;     // FLAT_TREE_MAGIC
+    uint32_t elem_size; // sizeof(T)
+    uint64_t count;     // 元素个数
+};
+constexpr uint32_t FLAT_TREE_MAGIC = 0x45595431; // "EYT1"
+constexpr size_t FLAT_DATA_OFFSET  = 64;         // 数据按缓存行对齐
+
+// 空聚合，不维护额外信息
+template <typename T>
+struct AVLNoAug {
+    struct value_type {};
+    static value_type identity() { return {}; }
+    static value_type from(const T &) { return {}; }
+    static value_type combine(const value_type &, const value_type &) { return {}; }
+};
+
+// 求和聚合，combine需满足结合律，identity为单位元
+template <typename T>
+struct AVLSumAug {
+    using value_type = T;
+    static value_type identity() { return T{}; }
+    static value_type from(const T &value) { return value; }
+    static value_type combine(const value_type &a, const value_type &b) { return a + b; }
+};
+
+// 节点聚合值存储: 空聚合作为空基类不占空间(C++17无[[no_unique_address]])
+template <typename V, bool = std::is_empty<V>::value>
+struct AVLAggSlot {
+    V agg; // 子树聚合值(按中序)
+
+    const V &get_agg() const { return agg; }
+    void set_agg(const V &value) { agg = value; }
+};
+
+template <typename V>
+struct AVLAggSlot<V, true> {
+    V get_agg() const { return V{}; }
+    void set_agg(const V &) {}
+};
+
 // 平衡二叉树节点类模板
-template <typename T> 
-class AVLNode {
+template <typename T, typename Aug = AVLNoAug<T>> 
+class AVLNode : public AVLAggSlot<typename Aug::value_type> {
 public:
     T data;            // 节点值
     int height;        // 节点高度
-    AVLNode<T> *left;  // 左子节点
-    AVLNode<T> *right; // 右子节点
+    int size;          // 子树节点数
+    AVLNode *left;     // 左子节点
+    AVLNode *right;    // 右子节点
 
     // 构造函数
     AVLNode(T value) {
         data = value;
         height = 1;
+        size = 1;
+        this->set_agg(Aug::from(data));
         left = nullptr;
         right = nullptr;
     }
 };
 
+// 不用聚合时节点大小不因聚合值增加
+static_assert(sizeof(AVLNode<long>) == sizeof(long) + 2 * sizeof(int) + 2 * sizeof(void *),
+              "AVLNode<long>: 空聚合不应占用节点空间");
+
 // 平衡二叉树操作类模板
-template <typename T> 
+template <typename T, typename Aug = AVLNoAug<T>> 
 class AVLTree {
 public:
-    AVLNode<T> *root;
+    using node_type = AVLNode<T, Aug>;
+    using agg_type  = typename Aug::value_type;
+
+    node_type *root;
 
     // 构造函数
     AVLTree() { 
         root = nullptr; 
     }
 
+    // 析构函数，释放全部节点
+    ~AVLTree() {
+        clear();
+    }
+
+    AVLTree(const AVLTree &) = delete;
+    AVLTree &operator=(const AVLTree &) = delete;
+
     // 计算节点高度
-    int get_height(AVLNode<T> *node) {
+    int get_height(node_type *node) const {
         if (node == nullptr)
             return 0;
         return node->height;
     }
 
     // 计算节点平衡因子
-    int get_balance_factor(AVLNode<T> *node) {
+    int get_balance_factor(node_type *node) {
         if (node == nullptr)
             return 0;
         return get_height(node->left) - get_height(node->right);
     }
 
-    // 更新节点高度
-    void update_height(AVLNode<T> *node) {
+    // 计算子树节点数
+    int get_size(node_type *node) const {
+        if (node == nullptr)
+            return 0;
+        return node->size;
+    }
+
+    // 计算子树聚合值
+    agg_type get_agg(node_type *node) const {
+        if (node == nullptr)
+            return Aug::identity();
+        return node->get_agg();
+    }
+
+    // 更新节点高度，同时更新子树大小与聚合值(旋转和插删回溯都经过这里)
+    void update_height(node_type *node) {
         if (node == nullptr)
             return;
         int leftHeight = get_height(node->left);
         int rightHeight = get_height(node->right);
         node->height = std::max(leftHeight, rightHeight) + 1;
+        node->size = get_size(node->left) + get_size(node->right) + 1;
+        node->set_agg(Aug::combine(Aug::combine(get_agg(node->left), Aug::from(node->data)), get_agg(node->right)));
     }
 
     // 右旋操作
-    AVLNode<T> *right_rotate(AVLNode<T> *node) {
-        AVLNode<T> *leftChild = node->left;
+    node_type *right_rotate(node_type *node) {
+        node_type *leftChild = node->left;
         node->left = leftChild->right;
         leftChild->right = node;
         update_height(node);
@@ -73,8 +167,8 @@ public:
     }
 
     // 左旋操作
-    AVLNode<T> *left_rotate(AVLNode<T> *node) {
-        AVLNode<T> *rightChild = node->right;
+    node_type *left_rotate(node_type *node) {
+        node_type *rightChild = node->right;
         node->right = rightChild->left;
         rightChild->left = node;
         update_height(node);
@@ -83,9 +177,9 @@ public:
     }
 
     // 插入节点
-    AVLNode<T> *insert_node(AVLNode<T> *node, T value) {
+    node_type *insert_node(node_type *node, T value) {
         if (node == nullptr)
-            return new AVLNode<T>(value);
+            return new node_type(value);
 
         if (value < node->data) {
             node->left = insert_node(node->left, value);
@@ -103,7 +197,7 @@ public:
     }
 
     // 中序遍历平衡二叉树
-    void inorder_traversal(AVLNode<T> *node) {
+    void inorder_traversal(node_type *node) {
         if (node == nullptr)
             return;
 
@@ -112,8 +206,22 @@ public:
         inorder_traversal(node->right);
     }
 
+    // 查找节点
+    node_type *find_node(node_type *node, const T &value) {
+        while (node != nullptr) {
+            if (value < node->data) {
+                node = node->left;
+            } else if (value > node->data) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
     // 寻找最小节点
-    AVLNode<T> *find_min_node(AVLNode<T> *node) {
+    node_type *find_min_node(node_type *node) {
         if (node == nullptr)
             return nullptr;
         if (node->left == nullptr)
@@ -122,7 +230,7 @@ public:
     }
 
     // 删除节点
-    AVLNode<T> *delete_node(AVLNode<T> *node, T value) {
+    node_type *delete_node(node_type *node, T value) {
         if (node == nullptr)
             return nullptr;
 
@@ -143,17 +251,17 @@ public:
                 return nullptr;
             } else if (node->left == nullptr) {
                 // 只有右子节点，用右子节点替换被删除节点
-                AVLNode<T> *rightChild = node->right;
+                node_type *rightChild = node->right;
                 delete node;
                 return rightChild;
             } else if (node->right == nullptr) {
                 // 只有左子节点，用左子节点替换被删除节点
-                AVLNode<T> *leftChild = node->left;
+                node_type *leftChild = node->left;
                 delete node;
                 return leftChild;
             } else {
                 // 有两个子节点，找到右子树中最小节点，用最小节点的值替换被删除节点的值，并删除最小节点
-                AVLNode<T> *minNode = find_min_node(node->right);
+                node_type *minNode = find_min_node(node->right);
                 node->data = minNode->data;
                 node->right = delete_node(node->right, minNode->data);
                 update_height(node);
@@ -166,15 +274,390 @@ public:
         return node;
     }
 
+    // 元素总数
+    int size() const {
+        return get_size(root);
+    }
+
+    // 排名: 小于value的元素个数
+    int rank(const T &value) const {
+        int count = 0;
+        node_type *node = root;
+        while (node != nullptr) {
+            if (node->data < value) {
+                count += get_size(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return count;
+    }
+
+    // 选择: 第k小的元素(从0开始)，越界返回false
+    bool select(int k, T &value) const {
+        if (k < 0 || k >= get_size(root))
+            return false;
+        node_type *node = root;
+        while (node != nullptr) {
+            int left_size = get_size(node->left);
+            if (k < left_size) {
+                node = node->left;
+            } else if (k > left_size) {
+                k -= left_size + 1;
+                node = node->right;
+            } else {
+                value = node->data;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 区间[lo, hi]内元素个数
+    int count_in_range(const T &lo, const T &hi) const {
+        if (hi < lo)
+            return 0;
+        return rank_upper(hi) - rank(lo);
+    }
+
+    // 区间[lo, hi]内元素按中序的聚合值，不要求聚合可逆
+    agg_type aggregate_range(const T &lo, const T &hi) const {
+        // 找到两条边界路径的分叉点
+        node_type *top = root;
+        while (top != nullptr && (top->data < lo || hi < top->data)) {
+            top = top->data < lo ? top->right : top->left;
+        }
+        if (top == nullptr)
+            return Aug::identity();
+
+        // 左边界: 分叉点左子树中>=lo的部分，越往下越小，拼在前面
+        agg_type left = Aug::identity();
+        for (node_type *node = top->left; node != nullptr;) {
+            if (node->data < lo) {
+                node = node->right;
+            } else {
+                left = Aug::combine(Aug::combine(Aug::from(node->data), get_agg(node->right)), left);
+                node = node->left;
+            }
+        }
+        // 右边界: 分叉点右子树中<=hi的部分，越往下越大，拼在后面
+        agg_type right = Aug::identity();
+        for (node_type *node = top->right; node != nullptr;) {
+            if (hi < node->data) {
+                node = node->left;
+            } else {
+                right = Aug::combine(right, Aug::combine(get_agg(node->left), Aug::from(node->data)));
+                node = node->right;
+            }
+        }
+        return Aug::combine(Aug::combine(left, Aug::from(top->data)), right);
+    }
+
+    // 冻结为平铺只读格式(Eytzinger布局)，写入buffer
+    bool freeze(std::vector<char> &buffer) {
+        static_assert(std::is_trivially_copyable<T>::value, "freeze requires trivially copyable T");
+        std::vector<T> sorted;
+        sorted.reserve(get_size(root));
+        std::vector<node_type *> stack;
+        node_type *node = root;
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            sorted.push_back(node->data);
+            node = node->right;
+        }
+
+        FlatTreeHeader header{FLAT_TREE_MAGIC, (uint32_t)sizeof(T), sorted.size()};
+        buffer.assign(FLAT_DATA_OFFSET + (sorted.size() + 1) * sizeof(T), 0);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        size_t next = 0;
+        eytzinger_fill(sorted, next, 1, buffer.data() + FLAT_DATA_OFFSET);
+        return true;
+    }
+
+    // 冻结并写入文件，之后可用FlatTreeFile映射
+    bool freeze(const std::string &path) {
+        std::vector<char> buffer;
+        freeze(buffer);
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        file.write(buffer.data(), buffer.size());
+        return file.good();
+    }
+
+    // 清空
+    void clear() {
+        free_tree(root);
+        root = nullptr;
+    }
+
+    // 由有序无重复序列O(n)构建，替换原有内容
+    template <typename RandomIt>
+    void build_from_sorted(RandomIt first, RandomIt last) {
+        clear();
+        root = build(first, last);
+    }
+
+    // 批量插入有序序列: 先O(m)建树再与原树求并；序列内重复的key只插入一次，与insert_node一致
+    template <typename RandomIt>
+    void insert_range(RandomIt first, RandomIt last) {
+        if (std::adjacent_find(first, last) == last) {
+            root = union_nodes(root, build(first, last), fork_depth());
+            return;
+        }
+        std::vector<T> unique_keys;
+        std::unique_copy(first, last, std::back_inserter(unique_keys));
+        root = union_nodes(root, build(unique_keys.begin(), unique_keys.end()), fork_depth());
+    }
+
+    // 并集，other的节点被并入本树，other置空
+    void union_with(AVLTree &other) {
+        root = union_nodes(root, other.root, fork_depth());
+        other.root = nullptr;
+    }
+
+    // 交集，只保留同时在other中的元素，other置空
+    void intersect_with(AVLTree &other) {
+        root = intersect_nodes(root, other.root, fork_depth());
+        other.root = nullptr;
+    }
+
+    // 差集，删除在other中的元素，other置空
+    void difference_with(AVLTree &other) {
+        root = difference_nodes(root, other.root, fork_depth());
+        other.root = nullptr;
+    }
+
 private:
+    // 子树规模低于该值时不再分叉
+    static constexpr int PARALLEL_GRAIN = 4096;
+
+    struct SplitResult {
+        node_type *left;  // 小于key的部分
+        node_type *mid;   // 等于key的节点(已摘下)，不存在为nullptr
+        node_type *right; // 大于key的部分
+    };
+
+    // 分叉深度: 约为log2(核数)+1，单核时不分叉
+    static int fork_depth() {
+        int depth = 0;
+        for (unsigned n = std::thread::hardware_concurrency(); n > 1; n >>= 1) {
+            depth++;
+        }
+        return depth == 0 ? 0 : depth + 1;
+    }
+
+    // 左右两个子任务，规模足够且还有分叉深度时左半放到新线程
+    template <typename Left, typename Right>
+    static void fork_join(bool fork, Left &&left, Right &&right) {
+        if (!fork) {
+            left();
+            right();
+            return;
+        }
+        auto future = std::async(std::launch::async, std::forward<Left>(left));
+        right();
+        future.get();
+    }
+
+    // 按Eytzinger下标的中序依次填入有序值
+    void eytzinger_fill(const std::vector<T> &sorted, size_t &next, size_t k, char *out) {
+        if (k > sorted.size())
+            return;
+        eytzinger_fill(sorted, next, 2 * k, out);
+        std::memcpy(out + k * sizeof(T), &sorted[next++], sizeof(T));
+        eytzinger_fill(sorted, next, 2 * k + 1, out);
+    }
+
+    // 释放子树
+    void free_tree(node_type *node) {
+        if (node == nullptr)
+            return;
+        free_tree(node->left);
+        free_tree(node->right);
+        delete node;
+    }
+
+    // 取中点递归建树，高度为ceil(log2(n+1))
+    template <typename RandomIt>
+    node_type *build(RandomIt first, RandomIt last) {
+        if (first == last)
+            return nullptr;
+        RandomIt mid = first + (last - first) / 2;
+        node_type *node = new node_type(*mid);
+        node->left = build(first, mid);
+        node->right = build(std::next(mid), last);
+        update_height(node);
+        return node;
+    }
+
+    // 以key为枢纽连接l与r，要求l < key < r
+    node_type *join(node_type *l, node_type *key, node_type *r) {
+        int leftHeight = get_height(l);
+        int rightHeight = get_height(r);
+        if (leftHeight > rightHeight + 1)
+            return join_right(l, key, r);
+        if (rightHeight > leftHeight + 1)
+            return join_left(l, key, r);
+        key->left = l;
+        key->right = r;
+        update_height(key);
+        return key;
+    }
+
+    // l较高: 沿l的右脊下降到与r高度相当处挂接，回溯时旋转
+    node_type *join_right(node_type *l, node_type *key, node_type *r) {
+        if (get_height(l) <= get_height(r) + 1) {
+            key->left = l;
+            key->right = r;
+            update_height(key);
+            return key;
+        }
+        l->right = join_right(l->right, key, r);
+        update_height(l);
+        return right_balance(l);
+    }
+
+    // r较高: 沿r的左脊下降
+    node_type *join_left(node_type *l, node_type *key, node_type *r) {
+        if (get_height(r) <= get_height(l) + 1) {
+            key->left = l;
+            key->right = r;
+            update_height(key);
+            return key;
+        }
+        r->left = join_left(l, key, r->left);
+        update_height(r);
+        return left_balance(r);
+    }
+
+    // 按key拆分子树，原子树被拆散重组
+    SplitResult split(node_type *node, const T &key) {
+        if (node == nullptr)
+            return {nullptr, nullptr, nullptr};
+        node_type *left = node->left;
+        node_type *right = node->right;
+        if (key < node->data) {
+            SplitResult result = split(left, key);
+            result.right = join(result.right, node, right);
+            return result;
+        }
+        if (node->data < key) {
+            SplitResult result = split(right, key);
+            result.left = join(left, node, result.left);
+            return result;
+        }
+        node->left = nullptr;
+        node->right = nullptr;
+        update_height(node);
+        return {left, node, right};
+    }
+
+    // 摘下最大节点，返回剩余子树
+    node_type *split_last(node_type *node, node_type *&last) {
+        if (node->right == nullptr) {
+            node_type *rest = node->left;
+            node->left = nullptr;
+            update_height(node);
+            last = node;
+            return rest;
+        }
+        node_type *rest = split_last(node->right, last);
+        return join(node->left, node, rest);
+    }
+
+    // 连接l与r，要求l < r
+    node_type *join2(node_type *l, node_type *r) {
+        if (l == nullptr)
+            return r;
+        node_type *last = nullptr;
+        node_type *rest = split_last(l, last);
+        return join(rest, last, r);
+    }
+
+    node_type *union_nodes(node_type *a, node_type *b, int depth) {
+        if (a == nullptr)
+            return b;
+        if (b == nullptr)
+            return a;
+        bool fork = depth > 0 && get_size(a) + get_size(b) > PARALLEL_GRAIN;
+        SplitResult parts = split(b, a->data);
+        delete parts.mid;
+        node_type *left = a->left;
+        node_type *right = a->right;
+        fork_join(
+            fork, [&]() { left = union_nodes(left, parts.left, depth - 1); },
+            [&]() { right = union_nodes(right, parts.right, depth - 1); });
+        return join(left, a, right);
+    }
+
+    node_type *intersect_nodes(node_type *a, node_type *b, int depth) {
+        if (a == nullptr || b == nullptr) {
+            free_tree(a);
+            free_tree(b);
+            return nullptr;
+        }
+        bool fork = depth > 0 && get_size(a) + get_size(b) > PARALLEL_GRAIN;
+        SplitResult parts = split(b, a->data);
+        node_type *left = a->left;
+        node_type *right = a->right;
+        fork_join(
+            fork, [&]() { left = intersect_nodes(left, parts.left, depth - 1); },
+            [&]() { right = intersect_nodes(right, parts.right, depth - 1); });
+        if (parts.mid != nullptr) {
+            delete parts.mid;
+            return join(left, a, right);
+        }
+        delete a;
+        return join2(left, right);
+    }
+
+    node_type *difference_nodes(node_type *a, node_type *b, int depth) {
+        if (a == nullptr || b == nullptr) {
+            free_tree(b);
+            return a;
+        }
+        bool fork = depth > 0 && get_size(a) + get_size(b) > PARALLEL_GRAIN;
+        SplitResult parts = split(a, b->data);
+        delete parts.mid;
+        node_type *left = b->left;
+        node_type *right = b->right;
+        fork_join(
+            fork, [&]() { left = difference_nodes(parts.left, left, depth - 1); },
+            [&]() { right = difference_nodes(parts.right, right, depth - 1); });
+        delete b;
+        return join2(left, right);
+    }
+
+    // 小于等于value的元素个数
+    int rank_upper(const T &value) const {
+        int count = 0;
+        node_type *node = root;
+        while (node != nullptr) {
+            if (value < node->data) {
+                node = node->left;
+            } else {
+                count += get_size(node->left) + 1;
+                node = node->right;
+            }
+        }
+        return count;
+    }
+
     // 右平衡
-    AVLNode<T> *right_balance(AVLNode<T> *node) {
+    node_type *right_balance(node_type *node) {
         int balanceFactor = get_balance_factor(node);
         if (balanceFactor == -2) {
-            if (get_balance_factor(node->right) == -1) {
-                // RR情况，进行左旋操作
+            if (get_balance_factor(node->right) <= 0) {
+                // RR情况(删除时右子树可能等高)，进行左旋操作
                 node = left_rotate(node);
-            } else if (get_balance_factor(node->right) == 1) {
+            } else {
                 // RL情况，先进行右旋操作，再进行左旋操作
                 node->right = right_rotate(node->right);
                 node = left_rotate(node);
@@ -184,13 +667,13 @@ private:
     }
 
     // 左平衡
-    AVLNode<T> *left_balance(AVLNode<T> *node) {
+    node_type *left_balance(node_type *node) {
         int balanceFactor = get_balance_factor(node);
         if (balanceFactor == 2) {
-            if (get_balance_factor(node->left) == 1) {
-                // LL情况，进行右旋操作
+            if (get_balance_factor(node->left) >= 0) {
+                // LL情况(删除时左子树可能等高)，进行右旋操作
                 node = right_rotate(node);
-            } else if (get_balance_factor(node->left) == -1) {
+            } else {
                 // LR情况，先进行左旋操作，再进行右旋操作
                 node->left = left_rotate(node->left);
                 node = right_rotate(node);
@@ -200,6 +683,577 @@ private:
     }
 };
 
+// arena版平衡二叉树节点，子节点为arena下标
+template <typename T> 
+struct AVLArenaNode {
+    T data;         // 节点值
+    uint32_t left;  // 左子节点下标
+    uint32_t right; // 右子节点下标
+    uint8_t height; // 节点高度
+};
+
+// arena版平衡二叉树
+// 1、所有节点在一个vector中，释放整棵树只需清空vector
+// 2、插入删除不递归，用显式路径栈回溯调整
+// 3、删除的节点进入空闲链表复用，data在复用前不析构
+template <typename T> 
+class AVLArenaTree {
+public:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr int MAX_DEPTH = 64; // 高度上限，远大于2^32个节点的AVL高度
+
+    AVLArenaTree()
+        : root{NIL}
+        , free_head{NIL}
+        , node_cnt{0} {}
+
+    // 预留节点空间，避免插入时扩容
+    void reserve(size_t n) {
+        nodes.reserve(n);
+    }
+
+    // 插入节点，已存在返回false
+    bool insert_node(const T &value) {
+        uint32_t path[MAX_DEPTH];
+        int depth = 0;
+        uint32_t cur = root;
+        while (cur != NIL) {
+            path[depth++] = cur;
+            if (value < nodes[cur].data) {
+                cur = nodes[cur].left;
+            } else if (nodes[cur].data < value) {
+                cur = nodes[cur].right;
+            } else {
+                return false;
+            }
+        }
+
+        uint32_t child = alloc_node(value);
+        node_cnt++;
+        // 自底向上更新高度并平衡，高度不变即可停止
+        while (depth > 0) {
+            uint32_t parent = path[--depth];
+            if (nodes[child].data < nodes[parent].data) {
+                nodes[parent].left = child;
+            } else {
+                nodes[parent].right = child;
+            }
+            uint8_t old_height = nodes[parent].height;
+            child = balance(parent);
+            if (child == parent && nodes[parent].height == old_height) {
+                return true;
+            }
+        }
+        root = child;
+        return true;
+    }
+
+    // 删除节点，不存在返回false
+    bool delete_node(const T &value) {
+        uint32_t path[MAX_DEPTH];
+        int depth = 0;
+        uint32_t cur = root;
+        while (cur != NIL) {
+            path[depth++] = cur;
+            if (value < nodes[cur].data) {
+                cur = nodes[cur].left;
+            } else if (nodes[cur].data < value) {
+                cur = nodes[cur].right;
+            } else {
+                break;
+            }
+        }
+        if (cur == NIL) {
+            return false;
+        }
+
+        // 有两个子节点，用右子树最小节点的值替换，转为删除最小节点
+        if (nodes[cur].left != NIL && nodes[cur].right != NIL) {
+            uint32_t min_node = nodes[cur].right;
+            path[depth++] = min_node;
+            while (nodes[min_node].left != NIL) {
+                min_node = nodes[min_node].left;
+                path[depth++] = min_node;
+            }
+            nodes[cur].data = nodes[min_node].data;
+            cur = min_node;
+        }
+
+        // 至多一个子节点，直接用子节点替换
+        uint32_t child = nodes[cur].left != NIL ? nodes[cur].left : nodes[cur].right;
+        depth--;
+        free_node(cur);
+        node_cnt--;
+        while (depth > 0) {
+            uint32_t parent = path[--depth];
+            if (nodes[parent].left == cur) {
+                nodes[parent].left = child;
+            } else {
+                nodes[parent].right = child;
+            }
+            cur = parent;
+            child = balance(parent);
+        }
+        root = child;
+        return true;
+    }
+
+    // 查找节点
+    bool find_node(const T &value) const {
+        uint32_t cur = root;
+        while (cur != NIL) {
+            if (value < nodes[cur].data) {
+                cur = nodes[cur].left;
+            } else if (nodes[cur].data < value) {
+                cur = nodes[cur].right;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 中序遍历，fn(const T&)
+    template <typename Func>
+    void for_each_inorder(Func &&fn) const {
+        uint32_t stack[MAX_DEPTH];
+        int depth = 0;
+        uint32_t cur = root;
+        while (cur != NIL || depth > 0) {
+            while (cur != NIL) {
+                stack[depth++] = cur;
+                cur = nodes[cur].left;
+            }
+            cur = stack[--depth];
+            fn(nodes[cur].data);
+            cur = nodes[cur].right;
+        }
+    }
+
+    // 中序遍历平衡二叉树
+    void inorder_traversal() const {
+        for_each_inorder([](const T &data) { std::cout << data << " "; });
+    }
+
+    // 清空，保留arena容量；data可平凡析构时为O(1)
+    void clear() {
+        nodes.clear();
+        root = NIL;
+        free_head = NIL;
+        node_cnt = 0;
+    }
+
+    // 清空并归还arena内存
+    void release() {
+        std::vector<AVLArenaNode<T>>().swap(nodes);
+        root = NIL;
+        free_head = NIL;
+        node_cnt = 0;
+    }
+
+    size_t size() const {
+        return node_cnt;
+    }
+
+    // 树高
+    int height() const {
+        return get_height(root);
+    }
+
+private:
+    int get_height(uint32_t node) const {
+        return node == NIL ? 0 : nodes[node].height;
+    }
+
+    void update_height(uint32_t node) {
+        nodes[node].height = (uint8_t)(std::max(get_height(nodes[node].left), get_height(nodes[node].right)) + 1);
+    }
+
+    int get_balance_factor(uint32_t node) const {
+        return get_height(nodes[node].left) - get_height(nodes[node].right);
+    }
+
+    // 右旋操作
+    uint32_t right_rotate(uint32_t node) {
+        uint32_t left_child = nodes[node].left;
+        nodes[node].left = nodes[left_child].right;
+        nodes[left_child].right = node;
+        update_height(node);
+        update_height(left_child);
+        return left_child;
+    }
+
+    // 左旋操作
+    uint32_t left_rotate(uint32_t node) {
+        uint32_t right_child = nodes[node].right;
+        nodes[node].right = nodes[right_child].left;
+        nodes[right_child].left = node;
+        update_height(node);
+        update_height(right_child);
+        return right_child;
+    }
+
+    // 更新高度并平衡，返回子树新的根
+    uint32_t balance(uint32_t node) {
+        update_height(node);
+        int balance_factor = get_balance_factor(node);
+        if (balance_factor > 1) {
+            if (get_balance_factor(nodes[node].left) < 0) {
+                nodes[node].left = left_rotate(nodes[node].left);
+            }
+            return right_rotate(node);
+        }
+        if (balance_factor < -1) {
+            if (get_balance_factor(nodes[node].right) > 0) {
+                nodes[node].right = right_rotate(nodes[node].right);
+            }
+            return left_rotate(node);
+        }
+        return node;
+    }
+
+    uint32_t alloc_node(const T &value) {
+        uint32_t idx;
+        if (free_head != NIL) {
+            idx = free_head;
+            free_head = nodes[idx].left;
+            nodes[idx].data = value;
+        } else {
+            idx = (uint32_t)nodes.size();
+            nodes.push_back({value, NIL, NIL, 1});
+            return idx;
+        }
+        nodes[idx].left = NIL;
+        nodes[idx].right = NIL;
+        nodes[idx].height = 1;
+        return idx;
+    }
+
+    // 空闲链表复用left字段
+    void free_node(uint32_t idx) {
+        nodes[idx].left = free_head;
+        free_head = idx;
+    }
+
+private:
+    std::vector<AVLArenaNode<T>> nodes; // arena
+    uint32_t root;
+    uint32_t free_head; // 空闲链表头
+    size_t node_cnt;
+};
+
+// 持久化平衡二叉树节点，创建后不再修改
+template <typename T>
+struct PersistentAVLNode {
+    using node_ptr = std::shared_ptr<const PersistentAVLNode>;
+
+    T data;
+    int height;
+    int size;
+    node_ptr left;
+    node_ptr right;
+
+    PersistentAVLNode(node_ptr l, const T &value, node_ptr r)
+        : data{value}
+        , height{std::max(l ? l->height : 0, r ? r->height : 0) + 1}
+        , size{(l ? l->size : 0) + (r ? r->size : 0) + 1}
+        , left{std::move(l)}
+        , right{std::move(r)} {}
+};
+
+/**
+ * 持久化平衡二叉树
+ * 1、insert/erase为纯函数，返回新根，只复制根到修改点的O(log n)个节点
+ * 2、树对象持有一个原子根: 写者串行生成新版本后原子发布，读者snapshot()取根即可，
+ *    快照期间写者的修改对其不可见，旧版本节点在最后一个快照释放时回收
+ */
+template <typename T>
+class PersistentAVLTree {
+public:
+    using node_type = PersistentAVLNode<T>;
+    using node_ptr  = typename node_type::node_ptr;
+
+    // 只读快照，可随意复制与跨线程传递
+    class Snapshot {
+    public:
+        Snapshot() = default;
+        explicit Snapshot(node_ptr root)
+            : root{std::move(root)} {}
+
+        // 查找
+        bool find_node(const T &value) const {
+            const node_type *node = root.get();
+            while (node != nullptr) {
+                if (value < node->data) {
+                    node = node->left.get();
+                } else if (node->data < value) {
+                    node = node->right.get();
+                } else {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // 中序遍历回调
+        template <typename Func>
+        void for_each_inorder(Func &&fn) const {
+            std::vector<const node_type *> stack;
+            const node_type *node = root.get();
+            while (node != nullptr || !stack.empty()) {
+                while (node != nullptr) {
+                    stack.push_back(node);
+                    node = node->left.get();
+                }
+                node = stack.back();
+                stack.pop_back();
+                fn(node->data);
+                node = node->right.get();
+            }
+        }
+
+        int size() const {
+            return root ? root->size : 0;
+        }
+
+        int height() const {
+            return root ? root->height : 0;
+        }
+
+        const node_ptr &get_root() const {
+            return root;
+        }
+
+    private:
+        node_ptr root;
+    };
+
+    PersistentAVLTree() = default;
+    PersistentAVLTree(const PersistentAVLTree &) = delete;
+    PersistentAVLTree &operator=(const PersistentAVLTree &) = delete;
+
+    // 插入，返回新根，已存在时返回原根
+    static node_ptr insert(const node_ptr &node, const T &value) {
+        if (node == nullptr)
+            return std::make_shared<const node_type>(nullptr, value, nullptr);
+        if (value < node->data) {
+            node_ptr left = insert(node->left, value);
+            if (left == node->left)
+                return node;
+            return balance(std::move(left), node->data, node->right);
+        }
+        if (node->data < value) {
+            node_ptr right = insert(node->right, value);
+            if (right == node->right)
+                return node;
+            return balance(node->left, node->data, std::move(right));
+        }
+        return node;
+    }
+
+    // 删除，返回新根，不存在时返回原根
+    static node_ptr erase(const node_ptr &node, const T &value) {
+        if (node == nullptr)
+            return nullptr;
+        if (value < node->data) {
+            node_ptr left = erase(node->left, value);
+            if (left == node->left)
+                return node;
+            return balance(std::move(left), node->data, node->right);
+        }
+        if (node->data < value) {
+            node_ptr right = erase(node->right, value);
+            if (right == node->right)
+                return node;
+            return balance(node->left, node->data, std::move(right));
+        }
+        if (node->left == nullptr)
+            return node->right;
+        if (node->right == nullptr)
+            return node->left;
+        // 有两个子节点: 用右子树最小值替换
+        const node_type *min_node = node->right.get();
+        while (min_node->left != nullptr) {
+            min_node = min_node->left.get();
+        }
+        T min_value = min_node->data;
+        return balance(node->left, min_value, erase(node->right, min_value));
+    }
+
+    // 写者插入并发布新版本，返回是否新插入
+    bool insert_node(const T &value) {
+        std::lock_guard<std::mutex> lock(write_mtx);
+        node_ptr old_root = std::atomic_load(&root);
+        node_ptr new_root = insert(old_root, value);
+        if (new_root == old_root)
+            return false;
+        std::atomic_store(&root, std::move(new_root));
+        return true;
+    }
+
+    // 写者删除并发布新版本，返回是否删除
+    bool delete_node(const T &value) {
+        std::lock_guard<std::mutex> lock(write_mtx);
+        node_ptr old_root = std::atomic_load(&root);
+        node_ptr new_root = erase(old_root, value);
+        if (new_root == old_root)
+            return false;
+        std::atomic_store(&root, std::move(new_root));
+        return true;
+    }
+
+    // 读者取快照，O(1)
+    Snapshot snapshot() const {
+        return Snapshot(std::atomic_load(&root));
+    }
+
+    // 回退到某个快照的版本
+    void restore(const Snapshot &snap) {
+        std::lock_guard<std::mutex> lock(write_mtx);
+        std::atomic_store(&root, snap.get_root());
+    }
+
+private:
+    static int get_height(const node_ptr &node) {
+        return node ? node->height : 0;
+    }
+
+    // 以value为根连接l与r，两侧高度差不超过2时旋转恢复平衡
+    static node_ptr balance(node_ptr l, const T &value, node_ptr r) {
+        int left_height = get_height(l);
+        int right_height = get_height(r);
+        if (left_height > right_height + 1) {
+            if (get_height(l->left) >= get_height(l->right)) {
+                // LL: 右旋
+                return std::make_shared<const node_type>(
+                    l->left, l->data, std::make_shared<const node_type>(l->right, value, std::move(r)));
+            }
+            // LR: 先左旋再右旋
+            const node_type *lr = l->right.get();
+            return std::make_shared<const node_type>(std::make_shared<const node_type>(l->left, l->data, lr->left),
+                                                     lr->data,
+                                                     std::make_shared<const node_type>(lr->right, value, std::move(r)));
+        }
+        if (right_height > left_height + 1) {
+            if (get_height(r->right) >= get_height(r->left)) {
+                // RR: 左旋
+                return std::make_shared<const node_type>(
+                    std::make_shared<const node_type>(std::move(l), value, r->left), r->data, r->right);
+            }
+            // RL: 先右旋再左旋
+            const node_type *rl = r->left.get();
+            return std::make_shared<const node_type>(std::make_shared<const node_type>(std::move(l), value, rl->left),
+                                                     rl->data,
+                                                     std::make_shared<const node_type>(rl->right, r->data, r->right));
+        }
+        return std::make_shared<const node_type>(std::move(l), value, std::move(r));
+    }
+
+    node_ptr root;         // 当前版本，只通过std::atomic_load/atomic_store访问
+    std::mutex write_mtx;  // 写者串行
+};
+
+// 平铺树只读视图，不拥有内存，可指向buffer或mmap区域
+template <typename T>
+class EytzingerView {
+public:
+    // 校验文件头并绑定数据，格式不符返回false
+    bool open(const void *buffer, size_t bytes) {
+        FlatTreeHeader header;
+        if (buffer == nullptr || bytes < FLAT_DATA_OFFSET)
+            return false;
+        std::memcpy(&header, buffer, sizeof(header));
+        if (header.magic != FLAT_TREE_MAGIC || header.elem_size != sizeof(T))
+            return false;
+        // 需容纳count+1个元素，写成除法避免count过大时乘法溢出
+        if (header.count >= (bytes - FLAT_DATA_OFFSET) / sizeof(T))
+            return false;
+        data = reinterpret_cast<const T *>(static_cast<const char *>(buffer) + FLAT_DATA_OFFSET);
+        count = header.count;
+        return true;
+    }
+
+    // 第一个不小于value的元素，不存在返回nullptr
+    const T *lower_bound(const T &value) const {
+        size_t k = 1;
+        while (k <= count) {
+            // 预取4层之后的16个后代，int时恰为一个缓存行
+            __builtin_prefetch(reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(data) + 16 * k * sizeof(T)));
+            k = 2 * k + (data[k] < value);
+        }
+        // 去掉末尾连续的1(向右走的步数)及其上一位，回到最后一次向左走的节点
+        k >>= __builtin_ffsll(~k);
+        return k == 0 ? nullptr : data + k;
+    }
+
+    // 查找
+    bool find_node(const T &value) const {
+        const T *found = lower_bound(value);
+        return found != nullptr && !(value < *found);
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    const T *data = nullptr;
+    size_t count = 0;
+};
+
+// mmap方式打开平铺树文件，零拷贝加载，多进程共享同一份页缓存
+template <typename T>
+class FlatTreeFile {
+public:
+    FlatTreeFile() = default;
+    FlatTreeFile(const FlatTreeFile &) = delete;
+    FlatTreeFile &operator=(const FlatTreeFile &) = delete;
+
+    ~FlatTreeFile() {
+        close();
+    }
+
+    bool open(const std::string &path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+        map_addr = addr;
+        map_size = st.st_size;
+        if (!flat.open(map_addr, map_size)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (map_addr != nullptr)
+            munmap(map_addr, map_size);
+        map_addr = nullptr;
+        map_size = 0;
+        flat = EytzingerView<T>();
+    }
+
+    const EytzingerView<T> &view() const {
+        return flat;
+    }
+
+private:
+    void *map_addr = nullptr;
+    size_t map_size = 0;
+    EytzingerView<T> flat;
+};
+
 } // namespace my_tree
 
 #endif
\ No newline at end of file
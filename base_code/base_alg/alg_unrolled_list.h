@@ -0,0 +1,289 @@
+#ifndef _MY_UNROLLED_LIST_H__
+#define _MY_UNROLLED_LIST_H__
+
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * 展开链表(分块链表)，存储 key+data
+ * 1、每个块存放CHUNK_SIZE个元素，key数组与data数组各自连续，整块遍历不需要逐个追指针
+ * 2、尾部追加均摊O(1)，删除时块内前移压实，块过空时与后继块合并
+ * 3、句柄通过句柄表间接定位，元素在块内或块间移动后句柄仍然有效
+ * 4、非线程安全，并发访问需外部加锁
+ */
+namespace my_list {
+
+// 元素句柄，gen用于识别已删除元素的过期句柄
+struct UnrolledHandle {
+    uint32_t id;
+    uint32_t gen;
+};
+
+template <typename T, int CHUNK_SIZE = 32>
+class unrolled_list {
+public:
+    using key_type = long;
+
+    explicit unrolled_list(bool log = false)
+        : list_head{nullptr}
+        , list_tail{nullptr}
+        , list_cur_size{0}
+        , log_switch{log} {}
+
+    ~unrolled_list() {
+        clear_list();
+    }
+
+    unrolled_list(const unrolled_list &) = delete;
+    unrolled_list &operator=(const unrolled_list &) = delete;
+
+    // 清空
+    int clear_list() {
+        while (list_head) {
+            Chunk *temp = list_head;
+            list_head = list_head->next;
+            destroy_chunk(temp);
+        }
+        list_tail = nullptr;
+        list_cur_size = 0;
+        // 保留句柄表，存活句柄代数加一后回收，清空前发出的句柄随之失效
+        for (uint32_t id = 0; id < slots.size(); id++) {
+            if (slots[id].chunk != nullptr) {
+                slots[id].chunk = nullptr;
+                slots[id].gen++;
+                free_ids.push_back(id);
+            }
+        }
+        return true;
+    }
+
+    // 尾部追加，返回句柄
+    template <typename... Args>
+    UnrolledHandle add_list(key_type key, Args &&...args) {
+        if (list_tail == nullptr || list_tail->count == CHUNK_SIZE) {
+            link_tail(new Chunk());
+        }
+        Chunk *chunk = list_tail;
+        int pos = chunk->count;
+        UnrolledHandle h = alloc_handle(chunk, pos);
+        chunk->keys[pos] = key;
+        chunk->ids[pos] = h.id;
+        new (chunk->value_ptr(pos)) T(std::forward<Args>(args)...);
+        chunk->count++;
+        list_cur_size++;
+        return h;
+    }
+
+    // 通过句柄删除
+    int del_list(UnrolledHandle h) {
+        if (!valid(h)) {
+            print_tip("del_list failed handle is invalid!:", h.id);
+            return false;
+        }
+        Slot &slot = slots[h.id];
+        erase_at(slot.chunk, slot.pos);
+        return true;
+    }
+
+    // 通过key删除第一个匹配的元素
+    int del_key(key_type key) {
+        int pos = 0;
+        Chunk *chunk = find_pos(key, pos);
+        if (chunk == nullptr) {
+            print_tip("key no exsit!:", key);
+            return false;
+        }
+        erase_at(chunk, pos);
+        return true;
+    }
+
+    // 句柄取值，句柄无效返回nullptr
+    T *get(UnrolledHandle h) {
+        if (!valid(h)) {
+            return nullptr;
+        }
+        return slots[h.id].chunk->value_ptr(slots[h.id].pos);
+    }
+
+    // 句柄是否有效
+    bool valid(UnrolledHandle h) const {
+        return h.id < slots.size() && slots[h.id].gen == h.gen && slots[h.id].chunk != nullptr;
+    }
+
+    // 查找第一个匹配key的元素并获取元素
+    int find_list(key_type key, T &data) {
+        int pos = 0;
+        Chunk *chunk = find_pos(key, pos);
+        if (chunk == nullptr) {
+            print_tip(" key is no exist!:", key);
+            return false;
+        }
+        data = *chunk->value_ptr(pos);
+        return true;
+    }
+
+    // 顺序遍历，fn(key, T&)
+    template <typename Func>
+    void for_each_list(Func &&fn) {
+        for (Chunk *chunk = list_head; chunk; chunk = chunk->next) {
+            if (chunk->next) {
+                __builtin_prefetch(chunk->next);
+            }
+            for (int i = 0; i < chunk->count; i++) {
+                fn(chunk->keys[i], *chunk->value_ptr(i));
+            }
+        }
+    }
+
+    // 获取大小
+    int get_list_size() {
+        return list_cur_size;
+    }
+
+    void print_list(std::string title) {
+        std::cout << title << ":chunk_size:" << CHUNK_SIZE << ","
+                  << "size:" << list_cur_size << std::endl;
+        for_each_list([](key_type key, T &data) { std::cout << "element:" << key << "," << data << std::endl; });
+    }
+
+private:
+    struct Chunk {
+        key_type keys[CHUNK_SIZE]; // key块，查找只扫这一块
+        uint32_t ids[CHUNK_SIZE];  // 元素对应的句柄id
+        alignas(T) unsigned char values[CHUNK_SIZE][sizeof(T)]; // data块
+        int count = 0;
+        Chunk *prev = nullptr;
+        Chunk *next = nullptr;
+
+        T *value_ptr(int pos) {
+            return reinterpret_cast<T *>(values[pos]);
+        }
+    };
+
+    struct Slot {
+        Chunk *chunk; // 空表示句柄已释放
+        int pos;
+        uint32_t gen;
+    };
+
+    Chunk *find_pos(key_type key, int &pos) {
+        for (Chunk *chunk = list_head; chunk; chunk = chunk->next) {
+            for (int i = 0; i < chunk->count; i++) {
+                if (chunk->keys[i] == key) {
+                    pos = i;
+                    return chunk;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    UnrolledHandle alloc_handle(Chunk *chunk, int pos) {
+        uint32_t id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+            slots[id].chunk = chunk;
+            slots[id].pos = pos;
+        } else {
+            id = (uint32_t)slots.size();
+            slots.push_back({chunk, pos, 0});
+        }
+        return {id, slots[id].gen};
+    }
+
+    // 元素移动到新位置，更新句柄表
+    void move_element(Chunk *from, int from_pos, Chunk *to, int to_pos) {
+        to->keys[to_pos] = from->keys[from_pos];
+        to->ids[to_pos] = from->ids[from_pos];
+        T *src = from->value_ptr(from_pos);
+        new (to->value_ptr(to_pos)) T(std::move(*src));
+        src->~T();
+        slots[to->ids[to_pos]].chunk = to;
+        slots[to->ids[to_pos]].pos = to_pos;
+    }
+
+    // 删除块内元素，后面的元素前移压实，块过空时合并后继块
+    void erase_at(Chunk *chunk, int pos) {
+        uint32_t id = chunk->ids[pos];
+        slots[id].chunk = nullptr;
+        slots[id].gen++;
+        free_ids.push_back(id);
+
+        chunk->value_ptr(pos)->~T();
+        for (int i = pos + 1; i < chunk->count; i++) {
+            move_element(chunk, i, chunk, i - 1);
+        }
+        chunk->count--;
+        list_cur_size--;
+
+        if (chunk->count == 0) {
+            unlink(chunk);
+            destroy_chunk(chunk);
+        } else if (chunk->count < CHUNK_SIZE / 4 && chunk->next &&
+                   chunk->count + chunk->next->count <= CHUNK_SIZE) {
+            Chunk *next = chunk->next;
+            for (int i = 0; i < next->count; i++) {
+                move_element(next, i, chunk, chunk->count++);
+            }
+            next->count = 0;
+            unlink(next);
+            destroy_chunk(next);
+        }
+    }
+
+    void link_tail(Chunk *chunk) {
+        chunk->prev = list_tail;
+        if (list_tail) {
+            list_tail->next = chunk;
+        } else {
+            list_head = chunk;
+        }
+        list_tail = chunk;
+    }
+
+    void unlink(Chunk *chunk) {
+        if (chunk->prev) {
+            chunk->prev->next = chunk->next;
+        } else {
+            list_head = chunk->next;
+        }
+        if (chunk->next) {
+            chunk->next->prev = chunk->prev;
+        } else {
+            list_tail = chunk->prev;
+        }
+    }
+
+    static void destroy_chunk(Chunk *chunk) {
+        for (int i = 0; i < chunk->count; i++) {
+            chunk->value_ptr(i)->~T();
+        }
+        delete chunk;
+    }
+
+    // 打印提示
+    template <typename... Args> void print_tip(const Args &...args) {
+        if (log_switch) {
+            std::cout << "Info: ";
+            ((std::cout << args), ...);
+            std::cout << std::endl;
+        }
+    }
+
+private:
+    Chunk *list_head;
+    Chunk *list_tail;
+    int list_cur_size;
+    bool log_switch; // log 打印开关
+    std::vector<Slot> slots;        // 句柄表
+    std::vector<uint32_t> free_ids; // 可复用的句柄id
+};
+
+} // namespace my_list
+
+#endif
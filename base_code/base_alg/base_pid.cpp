@@ -1,4 +1,12 @@
+#include "alg_pid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <random>
+#include <vector>
 
 class PIDController {
 private:
@@ -8,16 +16,18 @@ private:
     double setpoint;       // 设定值
     double previous_error; // 上一次误差
     double integral;       // 积分项
+    bool trace;            // 是否打印每次更新的p/i/d，基准测试时关闭
 
 public:
     // 构造函数
-    PIDController(double Kp, double Ki, double Kd, double setpoint) {
+    PIDController(double Kp, double Ki, double Kd, double setpoint, bool trace = true) {
         this->Kp = Kp;
         this->Ki = Ki;
         this->Kd = Kd;
         this->setpoint = setpoint;
         this->previous_error = 0;
         this->integral = 0;
+        this->trace = trace;
     }
 
     // 更新PID控制器状态并计算输出
@@ -26,7 +36,8 @@ public:
         integral += error * dt;
         double derivative = (error - previous_error) / dt;
         double output = Kp * error + Ki * integral + Kd * derivative;
-        std::cout << "p:" <<error << " i:" << integral << " d:" << derivative << std::endl;
+        if (trace)
+            std::cout << "p:" <<error << " i:" << integral << " d:" << derivative << std::endl;
         previous_error = error;
         return output;
     }
@@ -47,7 +58,8 @@ double get_dt() {
     return t;
 }
 
-int main() {
+// 单回路演示
+void test_pid_demo() {
     // 设置随机种子
     srand(static_cast<unsigned int>(time(nullptr)));
     // 创建PID控制器实例
@@ -68,6 +80,144 @@ int main() {
 
         input = measurement; // 更新输入为当前测量值
     }
+}
+
+// 随机生成count个回路的增益、设定值，以及ticks拍的测量值与dt
+struct PIDScenario {
+    std::vector<double> kp, ki, kd, setpoint;
+    std::vector<double> measurement; // ticks * count
+    std::vector<double> dt;          // ticks * count
+};
+
+PIDScenario make_scenario(size_t count, int ticks, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> gain(0.0, 1.0), value(-100.0, 100.0), step(0.001, 0.1);
+    PIDScenario s;
+    for (size_t i = 0; i < count; i++) {
+        s.kp.push_back(gain(rng));
+        s.ki.push_back(gain(rng) * 0.1);
+        s.kd.push_back(gain(rng) * 0.01);
+        s.setpoint.push_back(value(rng));
+    }
+    for (size_t i = 0; i < count * ticks; i++) {
+        s.measurement.push_back(value(rng));
+        s.dt.push_back(step(rng));
+    }
+    return s;
+}
+
+// 批量引擎与逐个回路的PIDController结果对比，覆盖各内核与非整向量长度的尾部
+template <typename T>
+bool check_batch(my_pid::Isa isa, size_t count, int ticks, double tolerance) {
+    PIDScenario s = make_scenario(count, ticks, 5);
+    std::vector<PIDController> scalar;
+    my_pid::PIDBatch<T> batch(isa);
+    for (size_t i = 0; i < count; i++) {
+        scalar.emplace_back(s.kp[i], s.ki[i], s.kd[i], s.setpoint[i], false);
+        batch.add((T)s.kp[i], (T)s.ki[i], (T)s.kd[i], (T)s.setpoint[i]);
+    }
+    std::vector<T> measurement(count), dt(count), output(count);
+    double max_diff = 0;
+    for (int t = 0; t < ticks; t++) {
+        // 中途改设定值，验证按回路设定
+        if (t == ticks / 2) {
+            for (size_t i = 0; i < count; i += 3) {
+                scalar[i] = PIDController(s.kp[i], s.ki[i], s.kd[i], -s.setpoint[i], false);
+                batch.set_setpoint(i, (T)-s.setpoint[i]);
+                batch.reset(i);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            measurement[i] = (T)s.measurement[t * count + i];
+            dt[i] = (T)s.dt[t * count + i];
+        }
+        batch.update(measurement.data(), dt.data(), output.data());
+        for (size_t i = 0; i < count; i++) {
+            double expect = scalar[i].update((double)measurement[i], (double)dt[i]);
+            max_diff = std::max(max_diff, std::fabs(expect - (double)output[i]) / std::max(1.0, std::fabs(expect)));
+        }
+    }
+    bool ok = max_diff <= tolerance;
+    std::cout << (sizeof(T) == sizeof(float) ? "float " : "double ") << my_pid::isa_name(batch.kernel())
+              << " loops:" << count << " max_rel_diff:" << max_diff << (ok ? " ok" : " FAIL") << std::endl;
+    return ok;
+}
+
+void test_pid_batch() {
+    std::cout << "cpu isa: " << my_pid::isa_name(my_pid::detect_isa()) << std::endl;
+    for (auto isa : {my_pid::Isa::SCALAR, my_pid::Isa::AVX2, my_pid::Isa::AVX512}) {
+        if (isa > my_pid::detect_isa())
+            continue;
+        check_batch<double>(isa, 1037, 20, 1e-9);
+        check_batch<float>(isa, 1037, 20, 1e-3);
+    }
+}
+
+volatile double bench_sink = 0; // 防止结果被优化掉
+
+// 返回每微秒更新的回路数
+template <typename Step>
+double loops_per_us(size_t count, int ticks, Step &&step) {
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) {
+        step(t);
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return count * (double)ticks / us;
+}
+
+template <typename T>
+double bench_batch(my_pid::Isa isa, const PIDScenario &s, size_t count, int ticks) {
+    my_pid::PIDBatch<T> batch(isa);
+    batch.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        batch.add((T)s.kp[i], (T)s.ki[i], (T)s.kd[i], (T)s.setpoint[i]);
+    }
+    std::vector<T> measurement(s.measurement.begin(), s.measurement.end());
+    std::vector<T> dt(s.dt.begin(), s.dt.end());
+    std::vector<T> output(count);
+    double rate = loops_per_us(count, ticks, [&](int t) {
+        batch.update(measurement.data() + t * count, dt.data() + t * count, output.data());
+    });
+    bench_sink = bench_sink + output[count / 2];
+    return rate;
+}
+
+// 对比逐个回路的PIDController与批量引擎，CSV: engine,type,isa,loops,ticks,loops_per_us
+void test_pid_bench(size_t count, int ticks) {
+    PIDScenario s = make_scenario(count, ticks, 9);
+    std::cout << "engine,type,isa,loops,ticks,loops_per_us" << std::endl;
+
+    std::vector<PIDController> scalar;
+    for (size_t i = 0; i < count; i++) {
+        scalar.emplace_back(s.kp[i], s.ki[i], s.kd[i], s.setpoint[i], false);
+    }
+    double sum = 0;
+    double rate = loops_per_us(count, ticks, [&](int t) {
+        for (size_t i = 0; i < count; i++) {
+            sum += scalar[i].update(s.measurement[t * count + i], s.dt[t * count + i]);
+        }
+    });
+    bench_sink = sum;
+    std::cout << "PIDController,double,scalar," << count << "," << ticks << "," << rate << std::endl;
+
+    for (auto isa : {my_pid::Isa::SCALAR, my_pid::Isa::AVX2, my_pid::Isa::AVX512}) {
+        if (isa > my_pid::detect_isa())
+            continue;
+        std::cout << "PIDBatch,double," << my_pid::isa_name(isa) << "," << count << "," << ticks << ","
+                  << bench_batch<double>(isa, s, count, ticks) << std::endl;
+        std::cout << "PIDBatch,float," << my_pid::isa_name(isa) << "," << count << "," << ticks << ","
+                  << bench_batch<float>(isa, s, count, ticks) << std::endl;
+    }
+}
 
+// 测试函数入口, 参数为回路数与基准测试拍数; 带参数时跳过单回路演示
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 16384;
+    int ticks    = argc > 2 ? std::stoi(argv[2]) : 200;
+    if (argc <= 1)
+        test_pid_demo();
+    test_pid_batch();
+    test_pid_bench(count, ticks);
     return 0;
 }
@@ -0,0 +1,325 @@
+#include "alg_bench.h"
+#include "alg_list.h"
+#include "alg_tree.h"
+#include <algorithm>
+#include <iostream>
+#include <malloc.h>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * 有序容器基准测试，输出CSV:
+ * container,workload,threads,elements,ops,mops,p50_ns,p99_ns,rss_bytes_per_elem,llc_miss_per_op
+ * 不适用的指标输出-1，无序容器不跑range_scan
+ */
+
+// 各容器统一接口: insert/find/erase/scan，scan返回-1表示不支持
+struct AVLBench {
+    static constexpr const char *name = "AVLTree";
+    static constexpr bool thread_safe = false;
+    my_tree::AVLTree<long> tree;
+
+    explicit AVLBench(long) {}
+    void insert(long key) { tree.root = tree.insert_node(tree.root, key); }
+    bool find(long key) { return tree.find_node(tree.root, key) != nullptr; }
+    void erase(long key) { tree.root = tree.delete_node(tree.root, key); }
+
+    // 从第一个>=lo的节点起中序取count个
+    long scan(long lo, int count) {
+        std::vector<my_tree::AVLNode<long> *> stack;
+        for (auto *node = tree.root; node != nullptr;) {
+            if (node->data < lo) {
+                node = node->right;
+            } else {
+                stack.push_back(node);
+                node = node->left;
+            }
+        }
+        long sum = 0;
+        for (int i = 0; i < count && !stack.empty(); i++) {
+            auto *node = stack.back();
+            stack.pop_back();
+            sum += node->data;
+            for (auto *child = node->right; child != nullptr; child = child->left) {
+                stack.push_back(child);
+            }
+        }
+        return sum;
+    }
+};
+
+struct ListBench {
+    static constexpr const char *name = "linked_list";
+    static constexpr bool thread_safe = true; // 内部全局锁
+    my_list::linked_list<long> list;
+
+    explicit ListBench(long n)
+        : list((int)n * 2) {}
+    void insert(long key) { list.add_list(key, key); }
+    bool find(long key) {
+        long data;
+        return list.find_list(key, data);
+    }
+    void erase(long key) { list.del_list(key); }
+    long scan(long, int) { return -1; }
+};
+
+struct MapBench {
+    static constexpr const char *name = "std::map";
+    static constexpr bool thread_safe = false;
+    std::map<long, long> map;
+
+    explicit MapBench(long) {}
+    void insert(long key) { map.emplace(key, key); }
+    bool find(long key) { return map.find(key) != map.end(); }
+    void erase(long key) { map.erase(key); }
+    long scan(long lo, int count) {
+        long sum = 0;
+        auto it = map.lower_bound(lo);
+        for (int i = 0; i < count && it != map.end(); i++, ++it) {
+            sum += it->first;
+        }
+        return sum;
+    }
+};
+
+struct SetBench {
+    static constexpr const char *name = "std::set";
+    static constexpr bool thread_safe = false;
+    std::set<long> set;
+
+    explicit SetBench(long) {}
+    void insert(long key) { set.insert(key); }
+    bool find(long key) { return set.find(key) != set.end(); }
+    void erase(long key) { set.erase(key); }
+    long scan(long lo, int count) {
+        long sum = 0;
+        auto it = set.lower_bound(lo);
+        for (int i = 0; i < count && it != set.end(); i++, ++it) {
+            sum += *it;
+        }
+        return sum;
+    }
+};
+
+struct HashBench {
+    static constexpr const char *name = "std::unordered_map";
+    static constexpr bool thread_safe = false;
+    std::unordered_map<long, long> map;
+
+    explicit HashBench(long) {}
+    void insert(long key) { map.emplace(key, key); }
+    bool find(long key) { return map.find(key) != map.end(); }
+    void erase(long key) { map.erase(key); }
+    long scan(long, int) { return -1; }
+};
+
+// 非线程安全容器加读写锁: 查找共享，修改独占
+template <typename Bench>
+class LockedBench {
+public:
+    explicit LockedBench(long n)
+        : bench{n} {}
+
+    void insert(long key) {
+        if constexpr (Bench::thread_safe) {
+            bench.insert(key);
+        } else {
+            std::unique_lock<std::shared_mutex> lock(mtx);
+            bench.insert(key);
+        }
+    }
+    bool find(long key) {
+        if constexpr (Bench::thread_safe) {
+            return bench.find(key);
+        } else {
+            std::shared_lock<std::shared_mutex> lock(mtx);
+            return bench.find(key);
+        }
+    }
+    void erase(long key) {
+        if constexpr (Bench::thread_safe) {
+            bench.erase(key);
+        } else {
+            std::unique_lock<std::shared_mutex> lock(mtx);
+            bench.erase(key);
+        }
+    }
+
+private:
+    Bench bench;
+    std::shared_mutex mtx;
+};
+
+struct BenchResult {
+    double mops;
+    double p50_ns;
+    double p99_ns;
+    double llc_per_op; // -1为不可用
+};
+
+// 计时并统计LLC缺失，body(sampler)执行全部操作
+template <typename Func>
+BenchResult measure(long ops, Func &&body) {
+    my_bench::LatencySampler sampler;
+    my_bench::LlcCounter llc;
+    llc.start();
+    auto start = std::chrono::steady_clock::now();
+    body(sampler);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    long misses = llc.stop();
+    return {ops / sec / 1e6, sampler.percentile(50), sampler.percentile(99),
+            misses < 0 ? -1.0 : (double)misses / ops};
+}
+
+void print_row(const char *container, const char *workload, int threads, long elements, long ops,
+               const BenchResult &result, double rss_per_elem = -1) {
+    std::cout << container << "," << workload << "," << threads << "," << elements << "," << ops << ","
+              << result.mops << "," << result.p50_ns << "," << result.p99_ns << "," << rss_per_elem << ","
+              << result.llc_per_op << std::endl;
+}
+
+volatile long bench_sink = 0; // 防止查找结果被优化掉
+
+// key取偶数，奇数key用于未命中查找
+template <typename Bench>
+void bench_single(long n) {
+    std::vector<long> keys(n);
+    for (long i = 0; i < n; i++) {
+        keys[i] = i * 2;
+    }
+    std::vector<long> shuffled(keys);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+    long sink = 0;
+
+    {
+        Bench bench(n);
+        auto result = measure(n, [&](my_bench::LatencySampler &sampler) {
+            for (long i = 0; i < n; i++) {
+                sampler.run(i, [&]() { bench.insert(keys[i]); });
+            }
+        });
+        print_row(Bench::name, "seq_insert", 1, n, n, result);
+    }
+
+    // 归还seq_insert释放的空闲堆内存，否则rand_insert会复用已驻留的页面
+    malloc_trim(0);
+    Bench bench(n);
+    size_t rss_before = my_bench::rss_bytes();
+    auto result = measure(n, [&](my_bench::LatencySampler &sampler) {
+        for (long i = 0; i < n; i++) {
+            sampler.run(i, [&]() { bench.insert(shuffled[i]); });
+        }
+    });
+    size_t rss_after = my_bench::rss_bytes();
+    double rss_per_elem = rss_after > rss_before ? (double)(rss_after - rss_before) / n : 0;
+    print_row(Bench::name, "rand_insert", 1, n, n, result, rss_per_elem);
+
+    // 热点打散到整个key空间
+    my_bench::ZipfGenerator zipf(n, 0.99, 11);
+    result = measure(n, [&](my_bench::LatencySampler &sampler) {
+        for (long i = 0; i < n; i++) {
+            long key = shuffled[zipf.next()];
+            sampler.run(i, [&]() { sink += bench.find(key); });
+        }
+    });
+    print_row(Bench::name, "zipf_lookup", 1, n, n, result);
+
+    // 删除为主: 50%删除 25%插入 25%查找
+    std::mt19937 rng(13);
+    result = measure(n, [&](my_bench::LatencySampler &sampler) {
+        for (long i = 0; i < n; i++) {
+            int op = rng() % 4;
+            long key = rng() % (n * 2);
+            if (op < 2) {
+                sampler.run(i, [&]() { bench.erase(key); });
+            } else if (op == 2) {
+                sampler.run(i, [&]() { bench.insert(key); });
+            } else {
+                sampler.run(i, [&]() { sink += bench.find(key); });
+            }
+        }
+    });
+    print_row(Bench::name, "delete_mix", 1, n, n, result);
+
+    // 区间扫描: 每次取100个
+    if (bench.scan(0, 1) >= 0) {
+        long scans = std::max(1L, n / 100);
+        result = measure(scans, [&](my_bench::LatencySampler &sampler) {
+            for (long i = 0; i < scans; i++) {
+                long lo = rng() % (n * 2);
+                sampler.run(i, [&]() { sink += bench.scan(lo, 100); });
+            }
+        });
+        print_row(Bench::name, "range_scan", 1, n, scans, result);
+    }
+    bench_sink = sink;
+}
+
+// 并发混合: 90%查找 5%插入 5%删除，Zipfian key
+template <typename Bench>
+void bench_concurrent(long n, int max_threads) {
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        LockedBench<Bench> bench(n);
+        for (long i = 0; i < n; i++) {
+            bench.insert(i * 2);
+        }
+        long ops_per_thread = std::max(1L, n / num_threads);
+        std::vector<my_bench::LatencySampler> samplers(num_threads);
+        auto result = measure(ops_per_thread * num_threads, [&](my_bench::LatencySampler &sampler) {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; t++) {
+                threads.emplace_back([&, t]() {
+                    my_bench::ZipfGenerator zipf(n, 0.99, 100 + t);
+                    std::mt19937 rng(t);
+                    for (long i = 0; i < ops_per_thread; i++) {
+                        int op = rng() % 100;
+                        long key = (long)((zipf.next() * 0x9E3779B97F4A7C15ull) % n) * 2;
+                        if (op < 90) {
+                            samplers[t].run(i, [&]() { bench.find(key); });
+                        } else if (op < 95) {
+                            samplers[t].run(i, [&]() { bench.insert(key + 1); });
+                        } else {
+                            samplers[t].run(i, [&]() { bench.erase(key + 1); });
+                        }
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            for (auto &per_thread : samplers) {
+                sampler.merge(per_thread);
+            }
+        });
+        print_row(Bench::name, "concurrent_mix", num_threads, n, ops_per_thread * num_threads, result);
+    }
+}
+
+template <typename Bench>
+void bench_container(long n, int max_threads) {
+    bench_single<Bench>(n);
+    bench_concurrent<Bench>(n, max_threads);
+}
+
+// 测试函数入口, 参数为元素个数与最大线程数; 链表为O(n)查找，元素个数单独限制
+int main(int argc, char *argv[]) {
+    long n          = argc > 1 ? std::stol(argv[1]) : 200000;
+    int max_threads = argc > 2 ? std::stoi(argv[2]) : 64;
+    long list_n     = std::min(n, 10000L);
+
+    std::cout << "container,workload,threads,elements,ops,mops,p50_ns,p99_ns,rss_bytes_per_elem,llc_miss_per_op"
+              << std::endl;
+    bench_container<AVLBench>(n, max_threads);
+    bench_container<MapBench>(n, max_threads);
+    bench_container<SetBench>(n, max_threads);
+    bench_container<HashBench>(n, max_threads);
+    bench_container<ListBench>(list_n, max_threads);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "alg_btree.h"
+#include "alg_tree.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+// 与std::set对照随机插入删除，小节点触发大量分裂合并
+template <int NODE_BYTES>
+void check_btree(int num, int range) {
+    my_tree::BPlusTree<int, NODE_BYTES> tree;
+    std::set<int> ref;
+    std::mt19937 rng(42);
+    bool find_ok = true;
+    for (int i = 0; i < num; i++) {
+        int value = rng() % range;
+        if (rng() % 2) {
+            if (tree.insert_node(value) != ref.insert(value).second)
+                find_ok = false;
+        } else {
+            if (tree.delete_node(value) != (ref.erase(value) == 1))
+                find_ok = false;
+        }
+        int probe = rng() % range;
+        if (tree.find_node(probe) != (ref.count(probe) == 1))
+            find_ok = false;
+    }
+    std::vector<int> values;
+    tree.for_each_inorder([&values](int v) { values.push_back(v); });
+    bool same = values.size() == ref.size() && std::equal(values.begin(), values.end(), ref.begin());
+
+    size_t range_cnt = tree.for_each_range(range / 4, range / 2, [](int) {});
+    size_t ref_cnt = std::distance(ref.lower_bound(range / 4), ref.upper_bound(range / 2));
+    std::cout << "node_bytes:" << NODE_BYTES << " size:" << tree.size() << " height:" << tree.height()
+              << " same as std::set:" << same << " find:" << find_ok << " range:" << (range_cnt == ref_cnt)
+              << std::endl;
+}
+
+void test_btree() {
+    my_tree::BPlusTree<std::string> tree;
+    tree.insert_node("banana");
+    tree.insert_node("apple");
+    tree.insert_node("cherry");
+    tree.insert_node("grape");
+    tree.insert_node("fig");
+    tree.inorder_traversal();
+    std::cout << std::endl;
+    tree.delete_node("apple");
+    tree.delete_node("fig");
+    tree.inorder_traversal();
+    std::cout << std::endl;
+
+    check_btree<64>(200000, 5000);
+    check_btree<256>(200000, 50000);
+
+    // 批量构建后继续增删
+    std::vector<int> sorted(100000);
+    for (int i = 0; i < (int)sorted.size(); i++) {
+        sorted[i] = i * 2;
+    }
+    my_tree::BPlusTree<int> bulk;
+    bulk.bulk_load(sorted.begin(), sorted.end(), 0.8);
+    bulk.insert_node(1);
+    bulk.delete_node(0);
+    std::cout << "bulk size:" << bulk.size() << " height:" << bulk.height() << " find 1:" << bulk.find_node(1)
+              << " find 0:" << bulk.find_node(0) << " find 199998:" << bulk.find_node(199998) << std::endl;
+}
+
+// 吞吐量对比: AVLTree / std::map / BPlusTree
+template <typename Func>
+double bench_mops(long ops, Func &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return ops / sec / 1e6;
+}
+
+void test_btree_bench(int num) {
+    std::vector<int> keys(num);
+    for (int i = 0; i < num; i++) {
+        keys[i] = i * 3;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+    std::vector<int> probes(keys);
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(9));
+    long sink = 0;
+
+    my_tree::AVLTree<int> avl_tree;
+    double avl_insert = bench_mops(num, [&]() {
+        for (int key : keys)
+            avl_tree.root = avl_tree.insert_node(avl_tree.root, key);
+    });
+    double avl_find = bench_mops(num, [&]() {
+        for (int key : probes)
+            sink += avl_tree.find_node(avl_tree.root, key) != nullptr;
+    });
+    double avl_scan = bench_mops(num, [&]() {
+        // AVLTree只有打印遍历，用显式栈做中序扫描
+        std::vector<my_tree::AVLNode<int> *> stack;
+        my_tree::AVLNode<int> *cur = avl_tree.root;
+        while (cur || !stack.empty()) {
+            while (cur) {
+                stack.push_back(cur);
+                cur = cur->left;
+            }
+            cur = stack.back();
+            stack.pop_back();
+            sink += cur->data;
+            cur = cur->right;
+        }
+    });
+
+    std::map<int, int> map;
+    double map_insert = bench_mops(num, [&]() {
+        for (int key : keys)
+            map.emplace(key, key);
+    });
+    double map_find = bench_mops(num, [&]() {
+        for (int key : probes)
+            sink += map.count(key);
+    });
+    double map_scan = bench_mops(num, [&]() {
+        for (auto &kv : map)
+            sink += kv.first;
+    });
+
+    my_tree::BPlusTree<int> btree;
+    double btree_insert = bench_mops(num, [&]() {
+        for (int key : keys)
+            btree.insert_node(key);
+    });
+    double btree_find = bench_mops(num, [&]() {
+        for (int key : probes)
+            sink += btree.find_node(key);
+    });
+    double btree_scan = bench_mops(num, [&]() { btree.for_each_inorder([&sink](int v) { sink += v; }); });
+
+    std::vector<int> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+    my_tree::BPlusTree<int> bulk;
+    double btree_bulk = bench_mops(num, [&]() { bulk.bulk_load(sorted.begin(), sorted.end()); });
+
+    std::cout << "keys:" << num << " sink:" << sink << std::endl;
+    std::cout << "container,insert(Mops),find(Mops),scan(Melem/s)" << std::endl;
+    std::cout << "AVLTree," << avl_insert << "," << avl_find << "," << avl_scan << std::endl;
+    std::cout << "std::map," << map_insert << "," << map_find << "," << map_scan << std::endl;
+    std::cout << "BPlusTree," << btree_insert << "," << btree_find << "," << btree_scan << std::endl;
+    std::cout << "BPlusTree bulk_load(Mops):" << btree_bulk << std::endl;
+}
+
+// 测试函数入口, 参数为基准测试的key数量
+int main(int argc, char *argv[]) {
+    int num = argc > 1 ? std::stoi(argv[1]) : 200000;
+    test_btree();
+    test_btree_bench(num);
+    return 0;
+}
@@ -1,4 +1,8 @@
 #include "alg_list.h"
+#include "alg_skip_list.h"
+#include "alg_unrolled_list.h"
+#include <atomic>
+#include <chrono>
 
 using namespace my_list;
 
@@ -119,6 +123,254 @@ void test_list_clear() {
     list.print_list("change");
 }
 
+// 批量接口与原地构造
+void test_list_batch() {
+    my_list::linked_list<std::string> list(16, true);
+    std::vector<std::pair<KEY_TYPE, std::string>> items;
+    for (int i = 0; i < 8; i++) {
+        items.emplace_back(i, "String_" + std::to_string(i));
+    }
+    items.emplace_back(3, "dup"); // 重复的key不会添加
+    std::cout << "add_many:" << list.add_many(std::move(items)) << std::endl;
+    list.print_list("batch-add");
+
+    std::vector<std::pair<KEY_TYPE, std::string>> datas;
+    std::cout << "find_many:" << list.find_many({1, 3, 5, 100}, datas) << std::endl;
+    for (auto &data : datas) {
+        std::cout << data.first << "," << data.second << std::endl;
+    }
+
+    std::cout << "del_many:" << list.del_many({0, 2, 4, 6, 100}) << std::endl;
+    list.print_list("batch-del");
+
+    // 大对象载荷: 原地构造，回调内修改，不拷贝
+    my_list::linked_list<std::vector<int>> vec_list;
+    vec_list.emplace_list(1, 1000, 7);
+    vec_list.with_value(1, [](std::vector<int> &v) { v.push_back(8); });
+    size_t vec_size = 0;
+    vec_list.with_value(1, [&vec_size](const std::vector<int> &v) { vec_size = v.size(); });
+    std::cout << "vector payload size:" << vec_size << std::endl;
+}
+
+// 跳表基本操作与区间查询
+void test_skip_list() {
+    my_list::skip_list<std::string> list(true);
+    for (int i = 9; i >= 0; i--) {
+        list.insert(i * 10, "String_" + std::to_string(i));
+    }
+    list.insert(30, "dup"); // 重复的key不会添加
+    list.print_list("skip-add");
+
+    list.erase(50);
+    list.erase(55); // 不存在
+    std::string data;
+    std::cout << "find 40:" << list.find(40, data) << "," << data << std::endl;
+    std::cout << "find 50:" << list.find(50, data) << std::endl;
+
+    std::cout << "range[25, 75]:";
+    for (auto &node : list.range(25, 75)) {
+        std::cout << " " << node.key;
+    }
+    std::cout << std::endl;
+}
+
+// 跳表并发测试: 多线程交错插入删除，同时做区间扫描检查有序
+void test_skip_list_thread() {
+    my_list::skip_list<long> list;
+    std::atomic<bool> stop{false};
+    std::atomic<long> unordered{0};
+    const int num_threads = 4;
+    const int num_keys    = 2000;
+
+    std::thread scanner([&list, &stop, &unordered]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            long prev = -1;
+            for (auto &node : list.range(100, 1500)) {
+                if (node.key <= prev || node.data() != node.key * 2)
+                    unordered++;
+                prev = node.key;
+            }
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&list, i]() {
+            for (int round = 0; round < 3; round++) {
+                for (long j = i; j < num_keys; j += num_threads) {
+                    list.insert(j, j * 2);
+                }
+                for (long j = i; j < num_keys; j += num_threads * 2) {
+                    list.erase(j);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    stop = true;
+    scanner.join();
+
+    long count = 0;
+    for (auto &node : list.all()) {
+        (void)node;
+        count++;
+    }
+    std::cout << "size:" << list.get_list_size() << " iterate:" << count << " unordered:" << unordered << std::endl;
+}
+
+// 展开链表: 追加、句柄、删除压实
+void test_unrolled_list() {
+    my_list::unrolled_list<std::string, 4> list(true);
+    std::vector<my_list::UnrolledHandle> handles;
+    for (int i = 0; i < 10; i++) {
+        handles.push_back(list.add_list(i, "String_" + std::to_string(i)));
+    }
+    list.print_list("unrolled-add");
+
+    // 删除后其余元素在块内/块间移动，句柄仍然有效
+    list.del_list(handles[1]);
+    list.del_list(handles[2]);
+    list.del_key(5);
+    list.del_list(handles[1]); // 已删除的句柄无效
+    list.print_list("unrolled-del");
+    std::cout << "handle 9:" << *list.get(handles[9]) << " handle 2 valid:" << list.valid(handles[2]) << std::endl;
+
+    // 清空后复用句柄槽位，旧句柄不能指向新元素
+    list.clear_list();
+    auto fresh = list.add_list(100, "String_100");
+    std::cout << "after clear handle 0 valid:" << list.valid(handles[0]) << " handle 9 valid:" << list.valid(handles[9])
+              << " new handle valid:" << list.valid(fresh) << std::endl;
+}
+
+// 全表扫描对比: 每节点一次分配的链表 vs 展开链表
+void test_list_scan_bench() {
+    const int num_keys = 1000000;
+    const int rounds   = 5;
+
+    my_list::linked_list<long> list(num_keys);
+    std::vector<std::pair<KEY_TYPE, long>> items;
+    items.reserve(num_keys);
+    for (long i = 0; i < num_keys; i++) {
+        items.emplace_back(i, i);
+    }
+    list.add_many(std::move(items));
+
+    my_list::unrolled_list<long> unrolled;
+    for (long i = 0; i < num_keys; i++) {
+        unrolled.add_list(i, i);
+    }
+
+    auto scan = [rounds](auto &container) {
+        long sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            container.for_each_list([&sum](long key, long &data) { sum += key + data; });
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(ns / rounds / num_keys, sum);
+    };
+    auto linked_ret   = scan(list);
+    auto unrolled_ret = scan(unrolled);
+    std::cout << "container,ns/element,checksum" << std::endl;
+    std::cout << "linked_list," << linked_ret.first << "," << linked_ret.second << std::endl;
+    std::cout << "unrolled_list," << unrolled_ret.first << "," << unrolled_ret.second << std::endl;
+}
+
+// 并发链表压力测试: 读者持续查找，写者同时增删
+void test_epoch_list_thread() {
+    my_list::epoch_list<std::string> list(1024);
+    std::atomic<bool> stop{false};
+    std::atomic<long> found{0}, wrong{0};
+    const int num_keys    = 256;
+    const int num_readers = 4;
+
+    for (int j = 0; j < num_keys; j++) {
+        list.add_list(j, "String_" + std::to_string(j));
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_readers; i++) {
+        threads.emplace_back([&list, &stop, &found, &wrong, i]() {
+            std::string data;
+            for (long j = i; !stop.load(std::memory_order_relaxed); j++) {
+                long key = j % num_keys;
+                if (list.find_list(key, data)) {
+                    found++;
+                    if (data != "String_" + std::to_string(key))
+                        wrong++;
+                }
+            }
+        });
+    }
+
+    // 写者反复删除再插入
+    threads.emplace_back([&list]() {
+        for (int round = 0; round < 200; round++) {
+            for (int j = round % 2; j < num_keys; j += 2) {
+                list.del_list(j);
+            }
+            for (int j = round % 2; j < num_keys; j += 2) {
+                list.add_list(j, "String_" + std::to_string(j));
+            }
+        }
+    });
+    threads.back().join();
+    threads.pop_back();
+    stop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::cout << "size:" << list.get_list_size() << " found:" << found << " wrong:" << wrong << std::endl;
+}
+
+// 吞吐量对比: 99%查找 1%增删
+template <typename List> 
+double list_bench_run(int num_threads, int num_keys, int ops_per_thread) {
+    List list(num_keys * 2);
+    for (int j = 0; j < num_keys; j++) {
+        list.add_list(j, "String_" + std::to_string(j));
+    }
+
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&list, i, num_keys, ops_per_thread]() {
+            std::string data;
+            unsigned seed = 12345u + i;
+            for (int j = 0; j < ops_per_thread; j++) {
+                seed = seed * 1103515245u + 12345u;
+                long key = (seed >> 8) % num_keys;
+                if (j % 100 == 0) {
+                    long extra = num_keys + i;
+                    list.add_list(extra, "extra");
+                    list.del_list(extra);
+                } else {
+                    list.find_list(key, data);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return num_threads * (double)ops_per_thread / sec;
+}
+
+void test_list_bench() {
+    const int num_keys = 256;
+    const int ops      = 20000;
+    std::cout << "threads,linked_list(ops/s),epoch_list(ops/s)" << std::endl;
+    for (int num_threads = 1; num_threads <= 8; num_threads *= 2) {
+        double locked = list_bench_run<my_list::linked_list<std::string>>(num_threads, num_keys, ops);
+        double epoch  = list_bench_run<my_list::epoch_list<std::string>>(num_threads, num_keys, ops);
+        std::cout << num_threads << "," << (long)locked << "," << (long)epoch << std::endl;
+    }
+}
+
 static int idx = 0;
 // 测试回调
 #define print_func(callback) do { \
@@ -137,5 +389,12 @@ int main(int argc, char *argv[]) {
     print_func(test_list_find);
     print_func(test_list_thread);
     print_func(test_list_clear);
+    print_func(test_list_batch);
+    print_func(test_epoch_list_thread);
+    print_func(test_skip_list);
+    print_func(test_skip_list_thread);
+    print_func(test_list_bench);
+    print_func(test_unrolled_list);
+    print_func(test_list_scan_bench);
     return 0;
 }
@@ -0,0 +1,160 @@
+#include "alg_bench.h"
+#include "alg_olc_tree.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+// 对照组: std::map + 读写锁
+class LockedMap {
+public:
+    bool find(long key, long &value) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = map.find(key);
+        if (it == map.end())
+            return false;
+        value = it->second;
+        return true;
+    }
+    bool insert(long key, long value) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        return map.insert_or_assign(key, value).second;
+    }
+    size_t scan(long lo, long hi, std::vector<std::pair<long, long>> &out, size_t limit) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        size_t cnt = 0;
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first <= hi && cnt < limit; ++it, ++cnt) {
+            out.emplace_back(it->first, it->second);
+        }
+        return cnt;
+    }
+
+private:
+    mutable std::shared_mutex mtx;
+    std::map<long, long> map;
+};
+
+// 并发正确性: 多线程交错插入/删除/查找，最后与预期对比
+void test_olc_tree() {
+    my_tree::OLCBTree<long, long, 128> tree; // 小节点，频繁分裂
+    const int num_threads = 4;
+    const long num_keys   = 20000;
+    std::atomic<long> wrong{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&tree, &wrong, i]() {
+            for (long j = i; j < num_keys; j += num_threads) {
+                tree.insert(j, j * 10);
+                long value = 0;
+                if (!tree.find(j, value) || value != j * 10)
+                    wrong++;
+                // 读其他线程的key，存在时值必须正确
+                long other = (j * 7919) % num_keys;
+                if (tree.find(other, value) && value != other * 10)
+                    wrong++;
+            }
+            for (long j = i; j < num_keys; j += num_threads * 2) {
+                if (!tree.remove(j))
+                    wrong++;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::pair<long, long>> out;
+    tree.scan(0, num_keys, out);
+    long expect = 0;
+    for (long j = 0; j < num_keys; j++) {
+        if (j % (num_threads * 2) >= num_threads)
+            expect++;
+    }
+    bool sorted = true;
+    for (size_t i = 1; i < out.size(); i++) {
+        sorted = sorted && out[i - 1].first < out[i].first;
+    }
+    std::cout << "size:" << out.size() << " expect:" << expect << " sorted:" << sorted << " wrong:" << wrong
+              << std::endl;
+}
+
+// YCSB风格混合负载
+struct Workload {
+    const char *name;
+    int read_pct;   // 点查
+    int update_pct; // 更新已有key
+    int insert_pct; // 插入新key
+    int scan_pct;   // 短区间扫描
+};
+
+template <typename Index>
+double run_workload(Index &index, const Workload &w, int num_threads, long num_keys, long ops_per_thread) {
+    std::atomic<long> next_key{num_keys};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&index, &w, &next_key, t, num_keys, ops_per_thread]() {
+            my_bench::ZipfGenerator zipf(num_keys, 0.99, 1000 + t);
+            std::mt19937 rng(t);
+            std::vector<std::pair<long, long>> out;
+            long value;
+            for (long i = 0; i < ops_per_thread; i++) {
+                int op = rng() % 100;
+                // 热点key打散到整个key空间
+                long key = (long)((zipf.next() * 0x9E3779B97F4A7C15ull) % num_keys);
+                if (op < w.read_pct) {
+                    index.find(key, value);
+                } else if (op < w.read_pct + w.update_pct) {
+                    index.insert(key, i);
+                } else if (op < w.read_pct + w.update_pct + w.insert_pct) {
+                    index.insert(next_key.fetch_add(1), i);
+                } else {
+                    out.clear();
+                    index.scan(key, key + 100, out, 50);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return num_threads * ops_per_thread / sec / 1e6;
+}
+
+void test_olc_ycsb(long num_keys, long ops) {
+    const Workload workloads[] = {
+        {"A", 50, 50, 0, 0},
+        {"B", 95, 5, 0, 0},
+        {"C", 100, 0, 0, 0},
+        {"E", 0, 0, 5, 95},
+    };
+    std::cout << "workload,threads,OLCBTree(Mops),map+shared_mutex(Mops)" << std::endl;
+    for (auto &w : workloads) {
+        for (int num_threads = 1; num_threads <= 8; num_threads *= 2) {
+            my_tree::OLCBTree<long, long> tree;
+            LockedMap map;
+            for (long k = 0; k < num_keys; k++) {
+                tree.insert(k, k);
+                map.insert(k, k);
+            }
+            double olc = run_workload(tree, w, num_threads, num_keys, ops / num_threads);
+            double locked = run_workload(map, w, num_threads, num_keys, ops / num_threads);
+            std::cout << w.name << "," << num_threads << "," << olc << "," << locked << std::endl;
+        }
+    }
+}
+
+// 测试函数入口, 参数为预加载key数量与每组总操作数
+int main(int argc, char *argv[]) {
+    long num_keys = argc > 1 ? std::stol(argv[1]) : 100000;
+    long ops      = argc > 2 ? std::stol(argv[2]) : 200000;
+    test_olc_tree();
+    test_olc_ycsb(num_keys, ops);
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "alg_queue.h"
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+
+// 对照组: 互斥锁+条件变量队列
+template <typename T>
+class cv_queue {
+public:
+    explicit cv_queue(size_t capacity = 1024)
+        : max_size{capacity} {}
+
+    void push(T data) {
+        std::unique_lock<std::mutex> lock(mtx);
+        not_full.wait(lock, [this] { return q.size() < max_size; });
+        q.push(std::move(data));
+        not_empty.notify_one();
+    }
+
+    void pop(T &data) {
+        std::unique_lock<std::mutex> lock(mtx);
+        not_empty.wait(lock, [this] { return !q.empty(); });
+        data = std::move(q.front());
+        q.pop();
+        not_full.notify_one();
+    }
+
+private:
+    size_t max_size;
+    std::queue<T> q;
+    std::mutex mtx;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+};
+
+// 单生产单消费: 顺序与内容
+void test_spsc_queue() {
+    my_queue::spsc_queue<std::string, true> q(4);
+    const int num = 1000;
+    long wrong = 0;
+    std::thread consumer([&q, &wrong]() {
+        std::string data;
+        for (int i = 0; i < num; i++) {
+            q.pop(data);
+            if (data != "String_" + std::to_string(i))
+                wrong++;
+        }
+    });
+    for (int i = 0; i < num; i++) {
+        q.push("String_" + std::to_string(i));
+    }
+    consumer.join();
+    std::cout << "capacity:" << q.capacity() << " empty:" << q.empty() << " wrong:" << wrong << std::endl;
+}
+
+// 多生产多消费: 每个元素恰好被消费一次
+void test_mpmc_queue() {
+    my_queue::mpmc_queue<long, true> q(8);
+    const int num_producers = 3;
+    const int num_consumers = 3;
+    const long num          = 3000;
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_producers; i++) {
+        threads.emplace_back([&q, i]() {
+            for (long j = i; j < num; j += num_producers) {
+                q.push(j);
+            }
+        });
+    }
+    for (int i = 0; i < num_consumers; i++) {
+        threads.emplace_back([&q, &sum]() {
+            long data;
+            for (long j = 0; j < num / num_consumers; j++) {
+                q.pop(data);
+                sum += data;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::cout << "sum:" << sum << " expect:" << num * (num - 1) / 2 << " empty:" << q.empty() << std::endl;
+}
+
+// 吞吐量: 单生产单消费传递num个元素
+template <typename Queue>
+double queue_throughput(long num) {
+    Queue q(1024);
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&q, num]() {
+        long data;
+        for (long i = 0; i < num; i++) {
+            q.pop(data);
+        }
+    });
+    for (long i = 0; i < num; i++) {
+        q.push(i);
+    }
+    consumer.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return num / sec;
+}
+
+// 交接延迟: 两个队列来回传递，取单程平均
+template <typename Queue>
+double queue_latency(long rounds) {
+    Queue ping(16), pong(16);
+    std::thread echo([&ping, &pong, rounds]() {
+        long data;
+        for (long i = 0; i < rounds; i++) {
+            ping.pop(data);
+            pong.push(data);
+        }
+    });
+    long data;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < rounds; i++) {
+        ping.push(i);
+        pong.pop(data);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    echo.join();
+    return ns / rounds / 2;
+}
+
+void test_queue_bench() {
+    const long num    = 1000000;
+    const long rounds = 20000;
+    std::cout << "queue,throughput(ops/s),latency(ns)" << std::endl;
+    std::cout << "cv_queue," << (long)queue_throughput<cv_queue<long>>(num) << ","
+              << queue_latency<cv_queue<long>>(rounds) << std::endl;
+    std::cout << "spsc_queue," << (long)queue_throughput<my_queue::spsc_queue<long, true>>(num) << ","
+              << queue_latency<my_queue::spsc_queue<long, true>>(rounds) << std::endl;
+    std::cout << "mpmc_queue," << (long)queue_throughput<my_queue::mpmc_queue<long, true>>(num) << ","
+              << queue_latency<my_queue::mpmc_queue<long, true>>(rounds) << std::endl;
+    std::cout << "spsc_queue(spin)," << (long)queue_throughput<my_queue::spsc_queue<long>>(num) << ","
+              << queue_latency<my_queue::spsc_queue<long>>(rounds) << std::endl;
+}
+
+static int idx = 0;
+// 测试回调
+#define print_func(callback) do { \
+    std::puts("\033[1;32m"); \
+    std::cout << "======[" << #callback << " function]======"; \
+    std::puts("\033[0m"); \
+    callback(); \
+    std::cout << "**[" << idx++ << "-" << #callback << " function]**********\n\n"; \
+} while(0)
+
+
+// 测试函数入口
+int main(int argc, char *argv[]) {
+    print_func(test_spsc_queue);
+    print_func(test_mpmc_queue);
+    print_func(test_queue_bench);
+    return 0;
+}
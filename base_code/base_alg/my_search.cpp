@@ -1,207 +1,795 @@
-#include <iostream>
-#include <queue>
-#include <vector>
-
-/**
- * 路径搜索
- */
-
-class MySearch {
-    using vector2 = std::vector<std::vector<int>>;
-
-private:
-    int m, n;
-    vector2 judge;
-    std::vector<std::pair<int, int>> path;
-    std::vector<std::vector<int>> array;
-
-public:
-    void init_search() {
-        judge.clear();
-        path.clear();
-        array.clear();
-    }
-
-    // 深度搜索，优先找到最深
-    bool DFSUtil(int x, int y, const vector2 &array, std::vector<std::pair<int, int>> &path) {
-        // 最后一个点
-        if (x == n - 1 && y == m - 1) {
-            judge[x][y] = 1;
-            if (array[x][y] == 1) {
-                path.push_back({x, y});
-                return true;
-            } else {
-                return false;
+#include "alg_search.h"
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <thread>
+
+// 算法测试
+void test_DFS_BFS() {
+    MySearch my_search;
+
+#if 1
+    std::vector<std::vector<int>> array = my_search.genrate_rand_array(5, 4);
+#else
+    std::vector<std::vector<int>> array = {
+        {1, 1, 1, 0, 1, 1, 0},
+        {1, 1, 1, 1, 1, 0, 0},
+        {0, 0, 0, 1, 0, 1, 0},
+        {1, 0, 0, 1, 0, 0, 0},
+        {0, 1, 0, 1, 1, 1, 1}
+    };
+    std::vector<std::vector<int>> array1 = {
+        {1, 0, 1, 1, 0, 1, 0},
+        {0, 1, 1, 1, 1, 0, 1},
+        {0, 0, 0, 1, 1, 1, 1},
+        {0, 1, 1, 0, 1, 1, 1},
+        {1, 0, 1, 1, 0, 0, 0}
+    };
+#endif
+    std::cout << std::boolalpha << std::endl;
+    std::cout << "DFS find path result: " << my_search.DFS_search(array) << std::endl;
+    std::cout << "BFS find path result: " << my_search.BFS_search(array) << std::endl;
+    std::cout << "A* find path result: " << my_search.AStar_search(array) << std::endl;
+    std::cout << "BiBFS find path result: " << my_search.BiBFS_search(array) << std::endl;
+    std::cout << "JPS find path result: " << my_search.JPS_search(array) << std::endl;
+    std::cout << std::noboolalpha << std::endl;
+}
+
+// 随机网格，density为可通行概率
+std::vector<std::vector<int>> random_grid(int rows, int cols, double density, std::mt19937 &rng) {
+    std::bernoulli_distribution open(density);
+    std::vector<std::vector<int>> grid(rows, std::vector<int>(cols));
+    for (auto &row : grid) {
+        for (int &cell : row) {
+            cell = open(rng) ? 1 : 0;
+        }
+    }
+    return grid;
+}
+
+// 参照: 普通BFS步数，不可达为-1
+int bfs_distance(const std::vector<std::vector<int>> &grid, my_search::Point start, my_search::Point goal) {
+    int rows = grid.size(), cols = grid[0].size();
+    if (!grid[start.first][start.second] || !grid[goal.first][goal.second])
+        return -1;
+    std::vector<int> dist(rows * cols, -1);
+    std::queue<my_search::Point> q;
+    q.push(start);
+    dist[start.first * cols + start.second] = 0;
+    int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    while (!q.empty()) {
+        auto p = q.front();
+        q.pop();
+        if (p == goal)
+            return dist[p.first * cols + p.second];
+        for (auto &dir : dirs) {
+            int x = p.first + dir[0], y = p.second + dir[1];
+            if (x >= 0 && x < rows && y >= 0 && y < cols && grid[x][y] && dist[x * cols + y] < 0) {
+                dist[x * cols + y] = dist[p.first * cols + p.second] + 1;
+                q.push({x, y});
             }
         }
-        // 超出范围或者是不可访问的点
-        if (x < 0 || x >= n || y < 0 || y >= m || array[x][y] == 0 || judge[x][y] == 1) {
+    }
+    return -1;
+}
+
+// 路径合法: 端点正确、相邻格连续且可通行
+bool valid_path(const std::vector<std::vector<int>> &grid, const std::vector<my_search::Point> &path,
+                my_search::Point start, my_search::Point goal, bool diagonal) {
+    if (path.empty() || path.front() != start || path.back() != goal)
+        return false;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (!grid[path[i].first][path[i].second])
             return false;
+        if (i == 0)
+            continue;
+        int dx = std::abs(path[i].first - path[i - 1].first);
+        int dy = std::abs(path[i].second - path[i - 1].second);
+        if (dx + dy == 0 || dx > 1 || dy > 1 || (!diagonal && dx + dy != 1))
+            return false;
+    }
+    return true;
+}
+
+// 参照: 普通BFS全图步数
+std::vector<int> bfs_all(const std::vector<std::vector<int>> &grid, my_search::Point start) {
+    int rows = grid.size(), cols = grid[0].size();
+    std::vector<int> dist(rows * cols, -1);
+    if (!grid[start.first][start.second])
+        return dist;
+    std::queue<my_search::Point> q;
+    q.push(start);
+    dist[start.first * cols + start.second] = 0;
+    int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    while (!q.empty()) {
+        auto p = q.front();
+        q.pop();
+        for (auto &dir : dirs) {
+            int x = p.first + dir[0], y = p.second + dir[1];
+            if (x >= 0 && x < rows && y >= 0 && y < cols && grid[x][y] && dist[x * cols + y] < 0) {
+                dist[x * cols + y] = dist[p.first * cols + p.second] + 1;
+                q.push({x, y});
+            }
         }
+    }
+    return dist;
+}
+
+// 位图网格: 整层BFS的步数与普通BFS一致，MySearch直接接收BitGrid
+void test_bit_grid() {
+    std::mt19937 rng(29);
+    my_search::FrontierBFS frontier;
+    std::vector<int> dist;
+    bool ok = true;
+    for (int round = 0; round < 300; round++) {
+        int rows = rng() % 70 + 1, cols = rng() % 200 + 1; // 覆盖跨字边界
+        auto grid = random_grid(rows, cols, 0.65, rng);
+        auto bits = my_search::BitGrid::from_array(grid);
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point goal{(int)(rng() % rows), (int)(rng() % cols)};
+        frontier.run(bits, start, {-1, -1}, &dist);
+        auto expect = bfs_all(grid, start);
+        ok = ok && dist == expect;
+        ok = ok && frontier.run(bits, start, goal) == expect[goal.first * cols + goal.second];
+        long reached = frontier.reach(bits, start);
+        ok = ok && reached == std::count_if(expect.begin(), expect.end(), [](int d) { return d >= 0; });
+    }
+    std::cout << "frontier BFS same as BFS:" << ok << std::endl;
+
+    std::vector<std::vector<int>> array = {
+        {1, 1, 1, 0, 1, 1, 0},
+        {1, 0, 1, 1, 1, 0, 0},
+        {1, 0, 0, 1, 0, 1, 0},
+        {1, 1, 0, 1, 1, 1, 1},
+        {0, 1, 1, 1, 0, 0, 1}
+    };
+    MySearch my_search;
+    auto bits = my_search::BitGrid::from_array(array);
+    std::cout << std::boolalpha;
+    std::cout << "DFS(BitGrid) find path result: " << my_search.DFS_search(bits) << std::endl;
+    std::cout << "BFS(BitGrid) find path result: " << my_search.BFS_search(bits) << std::endl;
+    std::cout << std::noboolalpha;
+}
+
+// 全图可达性与步数: 队列BFS vs 整层位运算BFS
+void test_bit_grid_bench() {
+    const int size = 2048;
+    std::mt19937 rng(31);
+    auto grid = random_grid(size, size, 0.75, rng);
+    auto bits = my_search::BitGrid::from_array(grid);
+    my_search::FrontierBFS frontier;
+    std::vector<int> dist;
+    long sink = 0;
+    // 从中心附近的可通行格出发
+    my_search::Point source{size / 2, size / 2};
+    while (!grid[source.first][source.second]) {
+        source.second++;
+    }
 
-        // 标记当前节点为路径的一部分
-        judge[x][y] = 1;
-        path.push_back({x, y});
+    auto start = std::chrono::steady_clock::now();
+    auto expect = bfs_all(grid, source);
+    double bfs_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    sink += frontier.reach(bits, source);
+    double reach_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    frontier.run(bits, source, {-1, -1}, &dist);
+    double dist_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-        // 向右移动
-        if (DFSUtil(x + 1, y, array, path))
-            return true;
+    std::cout << size << "x" << size << " grid bytes, vector<vector<int>>:" << (size_t)size * size * sizeof(int)
+              << " BitGrid:" << (size_t)size * bits.words_per_row() * 8 << std::endl;
+    std::cout << "whole-grid BFS(ms), queue:" << bfs_ms << " sweep reach:" << reach_ms
+              << " frontier dist:" << dist_ms << " layers:" << frontier.layers() << " reached:" << sink
+              << " same:" << (dist == expect) << std::endl;
+}
 
-        // 向下移动
-        if (DFSUtil(x, y + 1, array, path))
-            return true;
+// A*与双向BFS: 路径长度与普通BFS一致
+void test_astar_bibfs() {
+    std::mt19937 rng(17);
+    my_search::GridSearcher searcher;
+    std::vector<my_search::Point> path;
+    bool ok = true;
+    int found = 0;
+    for (int round = 0; round < 500; round++) {
+        int rows = rng() % 40 + 1, cols = rng() % 40 + 1;
+        auto grid = random_grid(rows, cols, 0.7, rng);
+        my_search::VectorGrid view(grid);
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point goal{(int)(rng() % rows), (int)(rng() % cols)};
+        int expect = bfs_distance(grid, start, goal);
 
-        // 如果这条路线不成功，反标记[x][y]并从路径中移除
-        judge[x][y] = 0;
-        path.pop_back();
+        bool astar_found = searcher.astar(view, start, goal, path);
+        ok = ok && astar_found == (expect >= 0);
+        ok = ok && (!astar_found || (valid_path(grid, path, start, goal, false) && (int)path.size() == expect + 1));
 
-        // 如果没有找到路径，返回失败
-        return false;
+        bool bibfs_found = searcher.bidirectional_bfs(view, start, goal, path);
+        ok = ok && bibfs_found == (expect >= 0);
+        ok = ok && (!bibfs_found || (valid_path(grid, path, start, goal, false) && (int)path.size() == expect + 1));
+
+        bool diagonal_found = searcher.astar(view, start, goal, path, true);
+        ok = ok && (!diagonal_found || valid_path(grid, path, start, goal, true));
+        ok = ok && (diagonal_found || !astar_found) && (!diagonal_found || (int)path.size() <= expect + 1 || expect < 0);
+        found += astar_found;
     }
+    std::cout << "found:" << found << "/500 same length as BFS:" << ok << std::endl;
+}
 
-    // 深度搜素，用于查找是否联通等
-    bool DFS_search(vector2 array) {
-        bool find_flag = false;
-        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
-            std::cout << "输入矩阵尺寸错误\n";
-            return false;
-        }
-        judge = std::vector<std::vector<int>>(n, std::vector<int>(m, 0));
-        // judge.assign(n, std::vector<int>(m, 0));
+// 大网格多次查询吞吐，暂存数组跨查询复用
+void test_search_bench() {
+    const int size = 2048;
+    const int queries = 200;
+    std::mt19937 rng(23);
+    auto grid = random_grid(size, size, 0.75, rng);
+    my_search::VectorGrid view(grid);
+    std::vector<std::pair<my_search::Point, my_search::Point>> pairs;
+    while ((int)pairs.size() < queries) {
+        my_search::Point a{(int)(rng() % size), (int)(rng() % size)};
+        my_search::Point b{(int)(rng() % 256) + a.first, (int)(rng() % 256) + a.second};
+        // 只取连通的点对，不可达查询会遍历整个连通块，单独衡量没有意义
+        if (b.first < size && b.second < size && bfs_distance(grid, a, b) >= 0)
+            pairs.push_back({a, b});
+    }
 
-        find_flag = DFSUtil(0, 0, array, path);
-        print_path(path);
+    my_search::GridSearcher searcher;
+    std::vector<my_search::Point> path;
+    long sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        sink += bfs_distance(grid, q.first, q.second);
+    }
+    double bfs_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        searcher.astar(view, q.first, q.second, path);
+        sink += path.size();
+    }
+    double astar_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        searcher.bidirectional_bfs(view, q.first, q.second, path);
+        sink += path.size();
+    }
+    double bibfs_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << size << "x" << size << " queries/s, BFS:" << queries / bfs_sec << " A*:" << queries / astar_sec
+              << " BiBFS:" << queries / bibfs_sec << " sink:" << sink << std::endl;
+}
 
-        return find_flag;
+// 迭代DFS与连通判断: 可达性与普通BFS一致；大网格蛇形通道不会栈溢出
+void test_iterative_dfs() {
+    std::mt19937 rng(31);
+    my_search::GridSearcher searcher;
+    std::vector<my_search::Point> path;
+    bool ok = true;
+    for (int round = 0; round < 500; round++) {
+        int rows = rng() % 40 + 1, cols = rng() % 40 + 1;
+        auto grid = random_grid(rows, cols, 0.6, rng);
+        my_search::VectorGrid view(grid);
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point goal{(int)(rng() % rows), (int)(rng() % cols)};
+        bool expect = bfs_distance(grid, start, goal) >= 0;
+        bool found = searcher.dfs(view, start, goal, path);
+        ok = ok && found == expect && (!found || valid_path(grid, path, start, goal, false));
+        ok = ok && searcher.connected(view, start, goal) == expect;
     }
 
-    // 广度搜素，用于查找最优解
-    bool BFS_search(vector2 array) {
-        bool find_flag = false;
-        if ((n = array.size()) == 0 || (m = array[0].size()) == 0) {
-            std::cout << "输入矩阵尺寸错误\n";
-            return false;
+    // 蛇形通道: 路径长度约为格子数的一半，递归版本会栈溢出
+    const int size = 4000;
+    std::vector<int> cells((size_t)size * size, 0);
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            bool corridor = x % 2 == 0 || (x % 4 == 1 && y == size - 1) || (x % 4 == 3 && y == 0);
+            cells[(size_t)x * size + y] = corridor ? 1 : 0;
+        }
+    }
+    my_search::GridView view(cells.data(), size, size);
+    my_search::Point goal{size - 2, size % 4 == 0 ? 0 : size - 1};
+    auto start = std::chrono::steady_clock::now();
+    bool found = searcher.dfs(view, {0, 0}, goal, path);
+    double dfs_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    bool reach = searcher.connected(view, {0, 0}, goal);
+    double connected_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "dfs same reachability as BFS:" << ok << " serpentine " << size << "x" << size
+              << " found:" << found << " path:" << path.size() << " connected:" << reach << " dfs_ms:"
+              << dfs_sec * 1000 << " connected_ms:" << connected_sec * 1000 << std::endl;
+}
+
+// 路径代价: 直走10，斜走14
+int path_cost(const std::vector<my_search::Point> &path) {
+    int cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        bool diagonal = path[i].first != path[i - 1].first && path[i].second != path[i - 1].second;
+        cost += diagonal ? my_search::GridSearcher::DIAGONAL_COST : my_search::GridSearcher::STRAIGHT_COST;
+    }
+    return cost;
+}
+
+// JPS/JPS+: 路径代价与八方向A*一致，跳跃表存盘后加载结果不变
+void test_jps() {
+    std::mt19937 rng(37);
+    my_search::GridSearcher searcher;
+    my_search::JumpTable table;
+    std::vector<my_search::Point> path;
+    bool ok = true;
+    int found = 0;
+    for (int round = 0; round < 500; round++) {
+        int rows = rng() % 40 + 1, cols = rng() % 40 + 1;
+        auto grid = random_grid(rows, cols, round % 2 ? 0.9 : 0.7, rng);
+        my_search::VectorGrid view(grid);
+        table.build(view);
+        // 在线跳跃距离与预计算表一致
+        for (int k = 0; k < 20; k++) {
+            int x = rng() % rows, y = rng() % cols, d = rng() % 8;
+            ok = ok && (!grid[x][y] || my_search::JumpTable::jump_distance(view, x, y, d) == table.distance(x, y, d));
         }
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point goal{(int)(rng() % rows), (int)(rng() % cols)};
+        bool astar_found = searcher.astar(view, start, goal, path, true);
+        int expect = astar_found ? path_cost(path) : -1;
 
-        judge = std::vector<std::vector<int>>(n, std::vector<int>(m, 0));
-        std::queue<std::pair<int, int>> q;
+        bool jps_found = searcher.jps(view, start, goal, path);
+        ok = ok && jps_found == astar_found && (!jps_found || (valid_path(grid, path, start, goal, true) &&
+                                                               path_cost(path) == expect));
+        bool plus_found = searcher.jps(view, start, goal, path, &table);
+        ok = ok && plus_found == astar_found && (!plus_found || (valid_path(grid, path, start, goal, true) &&
+                                                                 path_cost(path) == expect));
+        found += astar_found;
+    }
 
-        // 添加起点进入队列
-        if (array[0][0] == 0)
-            return false;
-        q.push({0, 0});
-        judge[0][0] = 1;
-
-        // 方向数组，表示相邻的四个方向（上下左右）
-        int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
-
-        while (!q.empty()) {
-            auto p = q.front();
-            q.pop();
-            int x = p.first, y = p.second;
-            path.push_back(p);
-
-            // 如果到达终点
-            if (x == n - 1 && y == m - 1) {
-                find_flag = true;
-                break;
+    // 开阔网格(仓库货架): 出堆节点数与耗时
+    const int size = 1024;
+    std::vector<std::vector<int>> grid(size, std::vector<int>(size, 1));
+    for (int x = 16; x + 16 < size; x += 24) {
+        for (int y = 16; y + 16 < size; y += 40) {
+            for (int k = 0; k < 32; k++) {
+                grid[x][y + k] = grid[x + 1][y + k] = 0;
             }
+        }
+    }
+    my_search::VectorGrid view(grid);
+    auto start = std::chrono::steady_clock::now();
+    table.build(view);
+    double build_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ok = ok && table.save("jump_table.bin");
+    my_search::JumpTable loaded;
+    ok = ok && loaded.load("jump_table.bin", view);
+    grid[0][0] = 0;
+    my_search::JumpTable stale;
+    ok = ok && !stale.load("jump_table.bin", my_search::VectorGrid(grid)); // 地图变化后拒绝加载
+    grid[0][0] = 1;
+    std::remove("jump_table.bin");
 
-            // 探索相邻节点
-            for (auto &dir : dirs) {
-                int next_x = x + dir[0];
-                int next_y = y + dir[1];
+    const int queries = 50;
+    std::vector<std::pair<my_search::Point, my_search::Point>> pairs;
+    while ((int)pairs.size() < queries) {
+        my_search::Point a{(int)(rng() % size), (int)(rng() % size)};
+        my_search::Point b{(int)(rng() % size), (int)(rng() % size)};
+        if (grid[a.first][a.second] && grid[b.first][b.second])
+            pairs.push_back({a, b});
+    }
+    long expanded[3] = {0, 0, 0};
+    double sec[3];
+    for (int algo = 0; algo < 3; algo++) {
+        start = std::chrono::steady_clock::now();
+        for (auto &q : pairs) {
+            if (algo == 0) {
+                searcher.astar(view, q.first, q.second, path, true);
+            } else {
+                searcher.jps(view, q.first, q.second, path, algo == 2 ? &loaded : nullptr);
+            }
+            expanded[algo] += searcher.expanded();
+        }
+        sec[algo] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout << "found:" << found << "/500 same cost as A*:" << ok << std::endl;
+    std::cout << size << "x" << size << " open grid, expanded/query A*:" << expanded[0] / queries
+              << " JPS:" << expanded[1] / queries << " JPS+:" << expanded[2] / queries
+              << " ms/query A*:" << sec[0] * 1000 / queries << " JPS:" << sec[1] * 1000 / queries
+              << " JPS+:" << sec[2] * 1000 / queries << " build_ms:" << build_sec * 1000 << std::endl;
+}
+
+// 多线程BFS: 各方向策略、各线程数的距离场与普通BFS一致；大图按线程数计时
+void test_parallel_bfs(int size) {
+    std::mt19937 rng(41);
+    bool ok = true;
+    my_search::ParallelBFS::Direction directions[] = {my_search::ParallelBFS::AUTO, my_search::ParallelBFS::TOP_DOWN,
+                                                      my_search::ParallelBFS::BOTTOM_UP};
+    std::vector<int> dist;
+    for (int round = 0; round < 60; round++) {
+        int rows = rng() % 100 + 1, cols = rng() % 100 + 1;
+        auto grid = random_grid(rows, cols, 0.65, rng);
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        auto expect = bfs_all(grid, start);
+        int expect_max = grid[start.first][start.second] ? *std::max_element(expect.begin(), expect.end()) : -1;
+        for (auto direction : directions) {
+            my_search::ParallelBFS bfs(round % 4 + 1, direction);
+            int max_dist = bfs.run(my_search::VectorGrid(grid), start, dist);
+            ok = ok && max_dist == expect_max && (expect_max < 0 || dist == expect);
+        }
+    }
+    MySearch my_search;
+    auto small = random_grid(30, 30, 0.7, rng);
+    bool reach = my_search.BFS_parallel(small, dist);
+    ok = ok && reach == (bfs_distance(small, {0, 0}, {29, 29}) >= 0);
+
+    auto grid = random_grid(size, size, 0.75, rng);
+    auto bits = my_search::BitGrid::from_array(grid);
+    my_search::Point source{size / 2, size / 2};
+    while (!grid[source.first][source.second]) {
+        source.second++;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto expect = bfs_all(grid, source);
+    double queue_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "parallel BFS same distances:" << ok << " " << size << "x" << size << " queue BFS(ms):"
+              << queue_sec * 1000 << std::endl;
+    int max_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        my_search::ParallelBFS bfs(threads);
+        start = std::chrono::steady_clock::now();
+        int layers = bfs.run(bits, source, dist);
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "threads:" << threads << " ms:" << sec * 1000 << " max_dist:" << layers
+                  << " top_down:" << bfs.top_down_levels() << " bottom_up:" << bfs.bottom_up_levels()
+                  << " same:" << (dist == expect) << std::endl;
+    }
+}
 
-                // 检查新位置是否可访问并且未被访问过
-                if (next_x >= 0 && next_x < n && next_y >= 0 && next_y < m && array[next_x][next_y] == 1 &&
-                    judge[next_x][next_y] == 0) {
-                    q.push({next_x, next_y});
-                    judge[next_x][next_y] = 1;
+// 连通块索引: 随机开关格子后与BFS可达性一致；批量查询与逐次DFS对比耗时
+void test_component_index() {
+    std::mt19937 rng(43);
+    my_search::ComponentIndex index;
+    bool ok = true;
+    for (int round = 0; round < 100; round++) {
+        int rows = rng() % 30 + 1, cols = rng() % 30 + 1;
+        auto grid = random_grid(rows, cols, 0.6, rng);
+        index.build(my_search::VectorGrid(grid));
+        for (int step = 0; step < 50; step++) {
+            int x = rng() % rows, y = rng() % cols;
+            grid[x][y] = rng() % 2;
+            index.set_cell({x, y}, grid[x][y] != 0);
+            my_search::Point a{(int)(rng() % rows), (int)(rng() % cols)};
+            my_search::Point b{(int)(rng() % rows), (int)(rng() % cols)};
+            ok = ok && index.connected(a, b) == (bfs_distance(grid, a, b) >= 0);
+        }
+        // 连通块个数与逐块BFS计数一致
+        std::vector<int> seen(rows * cols, 0);
+        int expect = 0;
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                if (!grid[x][y] || seen[x * cols + y])
+                    continue;
+                expect++;
+                auto dist = bfs_all(grid, {x, y});
+                for (int i = 0; i < rows * cols; i++) {
+                    seen[i] |= dist[i] >= 0;
                 }
             }
         }
-        if (!find_flag)
-            path.clear();
-        print_path(path);
-        return find_flag;
+        ok = ok && index.components() == expect;
     }
 
-    bool print_path(std::vector<std::pair<int, int>> path) {
-        if (path.size() == 0) {
-            std::cout << "没有找到路径" << std::endl;
-            return false;
-        } else {
-            std::cout << "发现路径:\n";
-            for (const auto &p : path) {
-                std::cout << '(' << p.first << ',' << p.second << ") -> ";
+    const int size = 2048;
+    const int queries = 100000;
+    auto grid = random_grid(size, size, 0.6, rng);
+    std::vector<std::pair<my_search::Point, my_search::Point>> pairs(queries);
+    for (auto &q : pairs) {
+        q = {{(int)(rng() % size), (int)(rng() % size)}, {(int)(rng() % size), (int)(rng() % size)}};
+    }
+    MySearch my_search;
+    std::vector<char> out;
+    auto start = std::chrono::steady_clock::now();
+    int connected = my_search.connected_many(grid, pairs, out);
+    double index_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // 逐次搜索只跑少量查询再折算
+    const int sample = 20;
+    my_search::GridSearcher searcher;
+    my_search::VectorGrid view(grid);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < sample; i++) {
+        ok = ok && searcher.connected(view, pairs[i].first, pairs[i].second) == (out[i] != 0);
+    }
+    double search_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "component index same as BFS:" << ok << " " << size << "x" << size << " " << queries
+              << " queries connected:" << connected << " index(ms):" << index_sec * 1000
+              << " per-query search(ms, extrapolated):" << search_sec / sample * queries * 1000 << std::endl;
+}
+
+// 分层寻路: 随机修改格子后可达性与BFS一致、路径合法，统计路径长度相对最短路的比例；大图对比A*
+void test_hpa() {
+    std::mt19937 rng(47);
+    bool ok = true;
+    long hpa_len = 0, best_len = 0;
+    for (int round = 0; round < 60; round++) {
+        int rows = rng() % 60 + 1, cols = rng() % 60 + 1;
+        auto grid = random_grid(rows, cols, 0.7, rng);
+        my_search::HierarchicalSearcher hpa(rng() % 8 + 2);
+        hpa.build(my_search::VectorGrid(grid));
+        std::vector<my_search::Point> path;
+        for (int step = 0; step < 30; step++) {
+            for (int k = 0; k < 3; k++) {
+                int x = rng() % rows, y = rng() % cols;
+                grid[x][y] = rng() % 4 != 0;
+                hpa.set_cell({x, y}, grid[x][y] != 0);
             }
-            std::cout << "END" << std::endl;
-            return true;
-        }
-    }
-
-    int get_rand_num(int start = 0, int end = 2) {
-        int t = rand() % (end - start) + start;
-        return t;
-    }
-
-    std::vector<std::vector<int>> genrate_rand_array(int n = 0, int m = 0) {
-        // 使用当前时间作为随机数生成器的种子
-        srand((unsigned)time(NULL));
-
-        n = (n == 0) ? get_rand_num(1, 20) : n;
-        m = (m == 0) ? get_rand_num(1, 20) : m;
-        std::cout << "n: " << n << " m: " << m << std::endl;
-        array.resize(n);
-        std::cout << "{\n";
-        for (int i = 0; i < n; i++) {
-            std::cout << "  { ";
-            array[i].reserve(m);
-            for (int j = 0; j < m; j++) {
-                array[i].push_back(get_rand_num());
-                std::cout << array[i].back();
-                if (j != m - 1)
-                    std::cout << ", ";
-                else
-                    std::cout << " ";
+            my_search::Point a{(int)(rng() % rows), (int)(rng() % cols)};
+            my_search::Point b{(int)(rng() % rows), (int)(rng() % cols)};
+            int expect = bfs_distance(grid, a, b);
+            bool found = hpa.find_path(a, b, path);
+            ok = ok && found == (expect >= 0) && (!found || valid_path(grid, path, a, b, false));
+            if (found) {
+                hpa_len += path.size() - 1;
+                best_len += expect;
             }
-            std::cout << "}" << std::endl;
+            // 同一簇对再查一次，走缓存
+            found = hpa.find_path(a, b, path);
+            ok = ok && found == (expect >= 0) && (!found || valid_path(grid, path, a, b, false));
         }
-        std::cout << "}" << std::endl;
-        return array;
     }
-};
+    std::cout << "HPA* same reachability as BFS:" << ok << " path length / shortest:" << (double)hpa_len / best_len
+              << std::endl;
 
-// 算法测试
-void test_DFS_BFS() {
+    const int size = 1024;
+    const int queries = 200;
+    auto grid = random_grid(size, size, 0.8, rng);
+    my_search::VectorGrid view(grid);
+    std::vector<std::pair<my_search::Point, my_search::Point>> pairs;
+    while ((int)pairs.size() < queries) {
+        my_search::Point a{(int)(rng() % size), (int)(rng() % size)};
+        my_search::Point b{(int)(rng() % size), (int)(rng() % size)};
+        if (grid[a.first][a.second] && grid[b.first][b.second])
+            pairs.push_back({a, b});
+    }
+    my_search::HierarchicalSearcher hpa;
+    auto start = std::chrono::steady_clock::now();
+    hpa.build(view);
+    double build_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::vector<my_search::Point> path;
+    long sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        hpa.find_path(q.first, q.second, path);
+        sink += path.size();
+    }
+    double hpa_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    my_search::GridSearcher searcher;
+    start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        searcher.astar(view, q.first, q.second, path);
+        sink += path.size();
+    }
+    double astar_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // 每次改几个格子后查询，只重算受影响的簇
+    long rebuilt = hpa.rebuilt_clusters();
+    start = std::chrono::steady_clock::now();
+    for (auto &q : pairs) {
+        for (int k = 0; k < 3; k++) {
+            hpa.set_cell({(int)(rng() % size), (int)(rng() % size)}, rng() % 2);
+        }
+        hpa.find_path(q.first, q.second, path);
+        sink += path.size();
+    }
+    double update_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << size << "x" << size << " clusters:" << hpa.cluster_count() << " nodes:" << hpa.node_count()
+              << " build(ms):" << build_sec * 1000 << " ms/query HPA*:" << hpa_sec * 1000 / queries
+              << " A*:" << astar_sec * 1000 / queries << " update+query:" << update_sec * 1000 / queries
+              << " clusters rebuilt/update:" << (double)(hpa.rebuilt_clusters() - rebuilt) / queries
+              << " cache hits:" << hpa.hits() << " sink:" << sink << std::endl;
+}
+
+// 参照: 二叉堆Dijkstra，多源距离场，不可达为-1
+std::vector<long> heap_dijkstra(const my_search::CostGrid &grid, const std::vector<my_search::Point> &sources,
+                                my_search::Point goal = {-1, -1}) {
+    int rows = grid.rows(), cols = grid.cols();
+    std::vector<long> dist((size_t)rows * cols, -1);
+    std::priority_queue<std::pair<long, int>, std::vector<std::pair<long, int>>, std::greater<>> heap;
+    for (auto &p : sources) {
+        if (grid.passable(p.first, p.second)) {
+            dist[p.first * cols + p.second] = 0;
+            heap.push({0, p.first * cols + p.second});
+        }
+    }
+    int goal_idx = goal.first * cols + goal.second;
+    int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    while (!heap.empty()) {
+        auto top = heap.top();
+        heap.pop();
+        if (top.first != dist[top.second])
+            continue;
+        if (top.second == goal_idx)
+            break;
+        int x = top.second / cols, y = top.second % cols;
+        for (auto &dir : dirs) {
+            int next_x = x + dir[0], next_y = y + dir[1];
+            if (next_x < 0 || next_x >= rows || next_y < 0 || next_y >= cols || !grid.passable(next_x, next_y))
+                continue;
+            long next = top.first + grid.cost(next_x, next_y);
+            long &old = dist[next_x * cols + next_y];
+            if (old < 0 || next < old) {
+                old = next;
+                heap.push({next, next_x * cols + next_y});
+            }
+        }
+    }
+    return dist;
+}
+
+// 随机代价网格: obstacle为障碍概率，其余代价1~max_cost
+my_search::CostGrid random_cost_grid(int rows, int cols, double obstacle, int max_cost, std::mt19937 &rng) {
+    my_search::CostGrid grid(rows, cols);
+    std::bernoulli_distribution blocked(obstacle);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            grid.set(x, y, blocked(rng) ? 0 : (int)(rng() % max_cost) + 1);
+        }
+    }
+    return grid;
+}
+
+// 权值最短路: Dial/基数堆的代价与二叉堆Dijkstra一致，路径代价自洽；多源距离场一致
+void test_weighted() {
+    std::mt19937 rng(53);
+    my_search::WeightedSearcher searcher;
+    std::vector<my_search::Point> path;
+    bool ok = true;
+    for (int round = 0; round < 300; round++) {
+        int rows = rng() % 40 + 1, cols = rng() % 40 + 1;
+        auto grid = random_cost_grid(rows, cols, 0.2, round % 2 ? 255 : 9, rng);
+        my_search::Point start{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point goal{(int)(rng() % rows), (int)(rng() % cols)};
+        long expect = heap_dijkstra(grid, {start})[goal.first * cols + goal.second];
+        for (int algo = 0; algo < 2; algo++) {
+            bool found = algo == 0 ? searcher.dial(grid, start, goal, path) : searcher.radix(grid, start, goal, path);
+            long cost = 0;
+            for (size_t i = 1; i < path.size(); i++) {
+                cost += grid.cost(path[i].first, path[i].second);
+            }
+            ok = ok && found == (expect >= 0) && (!found || (cost == expect && searcher.cost() == expect));
+        }
+        std::vector<my_search::Point> sources(rng() % 4 + 1);
+        for (auto &p : sources) {
+            p = {(int)(rng() % rows), (int)(rng() % cols)};
+        }
+        std::vector<int> dist;
+        searcher.distance_transform(grid, sources, dist);
+        auto expect_dist = heap_dijkstra(grid, sources);
+        ok = ok && std::equal(dist.begin(), dist.end(), expect_dist.begin());
+    }
     MySearch my_search;
+    std::vector<std::vector<int>> small = {{1, 9, 1}, {1, 9, 1}, {1, 1, 1}};
+    ok = ok && my_search.Dijkstra_search(small);
+    // 超过255的代价改用基数堆，负代价拒绝
+    std::vector<std::vector<int>> heavy = {{1, 300}, {400, 1}};
+    ok = ok && my_search.Dijkstra_search(heavy);
+    std::vector<std::vector<int>> negative = {{1, -1}, {1, 1}};
+    ok = ok && !my_search.Dijkstra_search(negative);
 
-#if 1
-    std::vector<std::vector<int>> array = my_search.genrate_rand_array(5, 4);
-#else
-    std::vector<std::vector<int>> array = {
-        {1, 1, 1, 0, 1, 1, 0},
-        {1, 1, 1, 1, 1, 0, 0},
-        {0, 0, 0, 1, 0, 1, 0},
-        {1, 0, 0, 1, 0, 0, 0},
-        {0, 1, 0, 1, 1, 1, 1}
-    };
-    std::vector<std::vector<int>> array1 = {
-        {1, 0, 1, 1, 0, 1, 0},
-        {0, 1, 1, 1, 1, 0, 1},
-        {0, 0, 0, 1, 1, 1, 1},
-        {0, 1, 1, 0, 1, 1, 1},
-        {1, 0, 1, 1, 0, 0, 0}
+    const int size = 2048;
+    const int queries = 10;
+    auto grid = random_cost_grid(size, size, 0.1, 255, rng);
+    std::vector<std::pair<my_search::Point, my_search::Point>> pairs;
+    while ((int)pairs.size() < queries) {
+        my_search::Point a{(int)(rng() % size), (int)(rng() % size)};
+        my_search::Point b{(int)(rng() % size), (int)(rng() % size)};
+        if (grid.passable(a.first, a.second) && grid.passable(b.first, b.second))
+            pairs.push_back({a, b});
+    }
+    long sink = 0;
+    double sec[3];
+    for (int algo = 0; algo < 3; algo++) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto &q : pairs) {
+            if (algo == 0) {
+                sink += heap_dijkstra(grid, {q.first}, q.second)[q.second.first * size + q.second.second];
+            } else if (algo == 1) {
+                searcher.dial(grid, q.first, q.second, path);
+                sink += searcher.cost();
+            } else {
+                searcher.radix(grid, q.first, q.second, path);
+                sink += searcher.cost();
+            }
+        }
+        sec[algo] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::vector<int> dist;
+    auto start = std::chrono::steady_clock::now();
+    searcher.distance_transform(grid, {{0, 0}, {size - 1, size - 1}, {size / 2, size / 2}}, dist);
+    double transform_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "weighted same cost as heap Dijkstra:" << ok << " " << size << "x" << size
+              << " ms/query heap:" << sec[0] * 1000 / queries << " Dial:" << sec[1] * 1000 / queries
+              << " radix:" << sec[2] * 1000 / queries << " 3-source transform(ms):" << transform_sec * 1000
+              << " sink:" << sink << std::endl;
+}
+
+// 分块网格: 写文件后逐格与原图一致，小缓存下A*/BFS结果与内存网格一致，常驻块数受限
+void test_tiled_grid() {
+    std::mt19937 rng(59);
+    const int rows = 3000, cols = 2500;
+    // 大片空地、大片障碍与随机区域混合，覆盖全通/全堵/压缩/原始四种块
+    auto grid = random_grid(rows, cols, 0.75, rng);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            if (x < 1024 && y < 1024)
+                grid[x][y] = 1;
+            else if (x >= 2048 && y >= 1536 && !(y % 200 == 0))
+                grid[x][y] = 0;
+            else if (x < 512 && y >= 1024)
+                grid[x][y] = (y / 7 + x / 9) % 5 != 0;
+        }
+    }
+    my_search::VectorGrid view(grid);
+    bool ok = my_search::TiledGrid::write("tiled_grid.bin", view, 256);
+    my_search::TiledGrid tiled;
+    ok = ok && tiled.open("tiled_grid.bin", 8);
+    ok = ok && tiled.rows() == rows && tiled.cols() == cols;
+    for (int x = 0; x < rows && ok; x++) {
+        for (int y = 0; y < cols; y++) {
+            ok = ok && tiled.passable(x, y) == (grid[x][y] != 0);
+        }
+    }
+    bool bounded = tiled.resident() <= 8;
+
+    my_search::GridSearcher searcher;
+    my_search::SparseSearcher sparse;
+    std::vector<my_search::Point> path, tiled_path;
+    int found = 0;
+    for (int q = 0; q < 20; q++) {
+        my_search::Point a{(int)(rng() % rows), (int)(rng() % cols)};
+        my_search::Point b{(int)(rng() % 600) + a.first, (int)(rng() % 600) + a.second};
+        if (b.first >= rows || b.second >= cols)
+            continue;
+        bool expect = searcher.astar(view, a, b, path);
+        bool got = sparse.astar(tiled, a, b, tiled_path);
+        ok = ok && got == expect && (!got || (tiled_path.size() == path.size() && valid_path(grid, tiled_path, a, b,
+                                                                                          false)));
+        got = sparse.bfs(tiled, a, b, tiled_path);
+        ok = ok && got == expect && (!got || tiled_path.size() == path.size());
+        got = searcher.astar(tiled, a, b, tiled_path);
+        ok = ok && got == expect && (!got || tiled_path.size() == path.size());
+        found += expect;
+    }
+    bounded = bounded && tiled.resident() <= 8;
+    std::ifstream file("tiled_grid.bin", std::ios::binary | std::ios::ate);
+    std::cout << "tiled grid same as memory:" << ok << " found:" << found << "/20 file bytes:" << file.tellg()
+              << " (dense bitset:" << (long)rows * cols / 8 << ") loads:" << tiled.loads()
+              << " evictions:" << tiled.evictions() << " resident<=8:" << bounded << std::endl;
+    tiled.close();
+    std::remove("tiled_grid.bin");
+
+    // 构造的损坏文件: 行数超出块网格、原始块长度不符、offset + bytes溢出，open都必须失败
+    auto open_crafted = [](uint64_t rows, uint8_t encoding, uint64_t offset, uint32_t bytes) {
+        my_search::TiledGridHeader header{my_search::TILED_GRID_MAGIC, 64, rows, 64, 1, 1};
+        my_search::TileIndex entry{offset, bytes, encoding, {0, 0, 0}};
+        std::vector<char> data(64, 0);
+        std::memcpy(data.data(), &header, sizeof(header));
+        std::memcpy(data.data() + sizeof(header), &entry, sizeof(entry));
+        std::ofstream("tiled_bad.bin", std::ios::binary).write(data.data(), data.size());
+        my_search::TiledGrid bad;
+        bool opened = bad.open("tiled_bad.bin");
+        std::remove("tiled_bad.bin");
+        return opened;
     };
-#endif
-    std::cout << std::boolalpha << std::endl;
-    std::cout << "DFS find path result: " << my_search.DFS_search(array) << std::endl;
-    std::cout << "BFS find path result: " << my_search.BFS_search(array) << std::endl;
-    std::cout << std::noboolalpha << std::endl;
+    bool rejected = open_crafted(64, my_search::TILE_BLOCKED, 0, 0);
+    rejected = rejected && !open_crafted(10000000, my_search::TILE_BLOCKED, 0, 0);
+    rejected = rejected && !open_crafted(64, my_search::TILE_RAW, 56, 8);
+    rejected = rejected && !open_crafted(64, my_search::TILE_RLE, UINT64_MAX - 4, 100);
+    std::cout << "tiled grid rejects corrupt headers:" << rejected << std::endl;
 }
 
-// 测试函数入口
+// 测试函数入口, 参数为多线程BFS计时用的网格边长
 int main(int argc, char *argv[]) {
+    int parallel_size = argc > 1 ? std::stoi(argv[1]) : 4096;
     test_DFS_BFS();
+    test_astar_bibfs();
+    test_search_bench();
+    test_bit_grid();
+    test_bit_grid_bench();
+    test_iterative_dfs();
+    test_jps();
+    test_parallel_bfs(parallel_size);
+    test_component_index();
+    test_hpa();
+    test_weighted();
+    test_tiled_grid();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,276 @@
+#include "alg_bench.h"
+#include "alg_grid_gen.h"
+#include "alg_search.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <random>
+#include <string>
+
+/**
+ * 网格搜索基准测试，输出CSV:
+ * generator,rows,cols,algorithm,queries,expanded_per_query,ns_per_query,mem_bytes,optimality
+ * 1、expanded_per_query: 出堆节点数(HPA*为抽象节点，sparse_astar为访问过的格子数)，算法不统计时为-1
+ * 2、mem_bytes: 算法运行前后常驻内存增量(运行前归还空闲堆内存)，即暂存数组的实际占用
+ * 3、optimality: 路径代价/最优代价的平均值，四方向算法对比BFS步数，八方向对比八方向A*代价
+ * 4、*_build行为预计算耗时，queries为1
+ * 5、frontier_bfs、parallel_bfs按步数表回溯路径；parallel_bfs每次查询求起点到全图的步数
+ * 6、tiled_bfs在分块网格文件上运行，分块文件写到当前目录，测试结束后删除
+ */
+using my_search::CostGrid;
+using my_search::Point;
+
+struct Query {
+    Point start;
+    Point goal;
+    long best4; // 四方向最短步数
+    long best8; // 八方向最小代价(直10斜14)
+};
+
+struct AlgoResult {
+    bool found;
+    long expanded; // -1为不统计
+};
+
+volatile long bench_sink = 0; // 防止结果被优化掉
+
+long octile_cost(const std::vector<Point> &path) {
+    long cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        bool diagonal = path[i].first != path[i - 1].first && path[i].second != path[i - 1].second;
+        cost += diagonal ? my_search::GridSearcher::DIAGONAL_COST : my_search::GridSearcher::STRAIGHT_COST;
+    }
+    return cost;
+}
+
+// 从同一连通块中取查询点对，并用A*算出两种移动方式的最优代价
+std::vector<Query> pick_queries(const CostGrid &grid, int count, uint64_t seed) {
+    std::vector<std::pair<Point, Point>> pairs;
+    {
+        my_search::ComponentIndex components;
+        components.build(grid);
+        std::mt19937_64 rng(seed);
+        for (int tries = 0; (int)pairs.size() < count && tries < count * 1000; tries++) {
+            Point a{(int)(rng() % grid.rows()), (int)(rng() % grid.cols())};
+            Point b{(int)(rng() % grid.rows()), (int)(rng() % grid.cols())};
+            if (components.label(a) >= 0 && components.connected(a, b))
+                pairs.push_back({a, b});
+        }
+    }
+    std::vector<Query> queries;
+    my_search::GridSearcher searcher;
+    std::vector<Point> path;
+    for (auto &pair : pairs) {
+        Query q{pair.first, pair.second, 0, 0};
+        searcher.astar(grid, q.start, q.goal, path);
+        q.best4 = (long)path.size() - 1;
+        searcher.astar(grid, q.start, q.goal, path, true);
+        q.best8 = octile_cost(path);
+        queries.push_back(q);
+    }
+    return queries;
+}
+
+void print_row(const std::string &generator, const CostGrid &grid, const char *algorithm, size_t queries,
+               double expanded, double ns, long mem, double optimality) {
+    std::cout << generator << "," << grid.rows() << "," << grid.cols() << "," << algorithm << "," << queries << ","
+              << expanded << "," << ns << "," << mem << "," << optimality << std::endl;
+}
+
+long rss_now() {
+    malloc_trim(0);
+    return (long)my_bench::rss_bytes();
+}
+
+// 沿步数递减从goal回溯到步数为0的起点，dist按行展开
+bool path_from_dist(const std::vector<int> &dist, int rows, int cols, Point goal, std::vector<Point> &path) {
+    static const int dirs[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    path.clear();
+    int steps = dist[(size_t)goal.first * cols + goal.second];
+    if (steps < 0)
+        return false;
+    path.resize(steps + 1);
+    int x = goal.first, y = goal.second;
+    for (int step = steps; step >= 0; step--) {
+        path[step] = {x, y};
+        for (auto &dir : dirs) {
+            int prev_x = x + dir[0], prev_y = y + dir[1];
+            if (prev_x >= 0 && prev_x < rows && prev_y >= 0 && prev_y < cols &&
+                dist[(size_t)prev_x * cols + prev_y] == step - 1) {
+                x = prev_x;
+                y = prev_y;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// make_searcher在计时前创建搜索器，run(searcher, q, path)执行一次查询；diagonal决定与哪种最优代价比较
+template <typename Make, typename Run>
+void bench_algo(const std::string &generator, const CostGrid &grid, const std::vector<Query> &queries,
+                const char *algorithm, bool diagonal, Make &&make_searcher, Run &&run) {
+    if (queries.empty())
+        return;
+    long rss_before = rss_now();
+    auto searcher = make_searcher();
+    std::vector<Point> path;
+    long expanded = 0, found = 0;
+    double ratio = 0;
+    bool counted = true;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &q : queries) {
+        AlgoResult result = run(*searcher, q, path);
+        counted = counted && result.expanded >= 0;
+        expanded += result.expanded;
+        if (!result.found)
+            continue;
+        found++;
+        long best = diagonal ? q.best8 : q.best4;
+        long cost = diagonal ? octile_cost(path) : (long)path.size() - 1;
+        ratio += best == 0 ? 1.0 : (double)cost / best;
+        bench_sink = bench_sink + (long)path.size();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    long mem = std::max(0L, (long)my_bench::rss_bytes() - rss_before);
+    print_row(generator, grid, algorithm, queries.size(), counted ? (double)expanded / queries.size() : -1,
+              ns / queries.size(), mem, found == 0 ? -1 : ratio / found);
+}
+
+// 预计算单独计时，查询阶段不计入
+template <typename Build>
+void bench_build(const std::string &generator, const CostGrid &grid, const char *name, Build &&build) {
+    long rss_before = rss_now();
+    auto start = std::chrono::steady_clock::now();
+    build();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    print_row(generator, grid, name, 1, -1, ns, std::max(0L, (long)my_bench::rss_bytes() - rss_before), -1);
+}
+
+void bench_grid(const std::string &generator, const CostGrid &grid, int query_cnt) {
+    auto queries = pick_queries(grid, query_cnt, 97);
+    using my_search::GridSearcher;
+
+    auto make_grid_searcher = []() { return std::make_unique<GridSearcher>(); };
+    bench_algo(generator, grid, queries, "astar", false, make_grid_searcher,
+               [&grid](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.astar(grid, q.start, q.goal, path), s.expanded()};
+               });
+    bench_algo(generator, grid, queries, "astar8", true, make_grid_searcher,
+               [&grid](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.astar(grid, q.start, q.goal, path, true), s.expanded()};
+               });
+    bench_algo(generator, grid, queries, "bibfs", false, make_grid_searcher,
+               [&grid](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.bidirectional_bfs(grid, q.start, q.goal, path), -1};
+               });
+    bench_algo(generator, grid, queries, "dfs", false, make_grid_searcher,
+               [&grid](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.dfs(grid, q.start, q.goal, path), -1};
+               });
+    bench_algo(generator, grid, queries, "jps", true, make_grid_searcher,
+               [&grid](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.jps(grid, q.start, q.goal, path), s.expanded()};
+               });
+
+    my_search::JumpTable table;
+    bench_build(generator, grid, "jps+_build", [&]() { table.build(grid); });
+    bench_algo(generator, grid, queries, "jps+", true, make_grid_searcher,
+               [&grid, &table](GridSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.jps(grid, q.start, q.goal, path, &table), s.expanded()};
+               });
+    table = my_search::JumpTable();
+
+    my_search::HierarchicalSearcher hpa;
+    bench_build(generator, grid, "hpa_build", [&]() { hpa.build(grid); });
+    bench_algo(generator, grid, queries, "hpa", false, [&hpa]() { return &hpa; },
+               [](my_search::HierarchicalSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.find_path(q.start, q.goal, path), s.expanded()};
+               });
+
+    bench_algo(generator, grid, queries, "dial", false,
+               []() { return std::make_unique<my_search::WeightedSearcher>(); },
+               [&grid](my_search::WeightedSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.dial(grid, q.start, q.goal, path), -1};
+               });
+    bench_algo(generator, grid, queries, "radix", false,
+               []() { return std::make_unique<my_search::WeightedSearcher>(); },
+               [&grid](my_search::WeightedSearcher &s, const Query &q, std::vector<Point> &path) {
+                   return AlgoResult{s.radix(grid, q.start, q.goal, path), -1};
+               });
+    bench_algo(generator, grid, queries, "sparse_astar", false,
+               []() { return std::make_unique<my_search::SparseSearcher>(); },
+               [&grid](my_search::SparseSearcher &s, const Query &q, std::vector<Point> &path) {
+                   bool found = s.astar(grid, q.start, q.goal, path);
+                   return AlgoResult{found, (long)s.visited()};
+               });
+
+    int rows = grid.rows(), cols = grid.cols();
+    my_search::BitGrid bits;
+    bench_build(generator, grid, "bitgrid_build", [&]() {
+        bits = my_search::BitGrid(rows, cols);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                bits.set(x, y, grid.passable(x, y));
+            }
+        }
+    });
+    std::vector<int> dist;
+    bench_algo(generator, grid, queries, "frontier_bfs", false,
+               []() { return std::make_unique<my_search::FrontierBFS>(); },
+               [&](my_search::FrontierBFS &s, const Query &q, std::vector<Point> &path) {
+                   s.run(bits, q.start, q.goal, &dist);
+                   return AlgoResult{path_from_dist(dist, rows, cols, q.goal, path), -1};
+               });
+    bits = my_search::BitGrid();
+    bench_algo(generator, grid, queries, "parallel_bfs", false,
+               []() { return std::make_unique<my_search::ParallelBFS>(); },
+               [&](my_search::ParallelBFS &s, const Query &q, std::vector<Point> &path) {
+                   s.run(grid, q.start, dist);
+                   return AlgoResult{path_from_dist(dist, rows, cols, q.goal, path), -1};
+               });
+    dist = std::vector<int>();
+
+    const char *tile_file = "search_bench_tiles.bin";
+    my_search::TiledGrid tiled;
+    bench_build(generator, grid, "tiled_build", [&]() {
+        if (!my_search::TiledGrid::write(tile_file, grid) || !tiled.open(tile_file))
+            std::cerr << "写分块网格失败: " << tile_file << std::endl;
+    });
+    if (tiled.rows() == rows) {
+        bench_algo(generator, grid, queries, "tiled_bfs", false,
+                   []() { return std::make_unique<my_search::SparseSearcher>(); },
+                   [&tiled](my_search::SparseSearcher &s, const Query &q, std::vector<Point> &path) {
+                       bool found = s.bfs(tiled, q.start, q.goal, path);
+                       return AlgoResult{found, (long)s.visited()};
+                   });
+    }
+    tiled.close();
+    std::remove(tile_file);
+}
+
+// 测试函数入口, 参数为最大边长(默认1024，最大16384)与可选的Moving-AI .map文件
+int main(int argc, char *argv[]) {
+    int max_size = argc > 1 ? std::stoi(argv[1]) : 1024;
+
+    std::cout << "generator,rows,cols,algorithm,queries,expanded_per_query,ns_per_query,mem_bytes,optimality"
+              << std::endl;
+    for (int size = 256; size <= std::min(max_size, 16384); size *= 4) {
+        int query_cnt = std::max(5, 100 * 256 / size);
+        bench_grid("random70", my_search::random_density(size, size, 0.7, 1), query_cnt);
+        bench_grid("maze", my_search::maze(size, size, 2), query_cnt);
+        bench_grid("rooms", my_search::rooms(size, size, 3), query_cnt);
+    }
+    for (int i = 2; i < argc; i++) {
+        CostGrid grid;
+        if (!my_search::load_moving_ai(argv[i], grid)) {
+            std::cerr << "读取地图失败: " << argv[i] << std::endl;
+            continue;
+        }
+        std::string name = argv[i];
+        bench_grid(name.substr(name.find_last_of('/') + 1), grid, 50);
+    }
+    return 0;
+}
@@ -1,4 +1,13 @@
+#include "alg_interval_tree.h"
 #include "alg_tree.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <set>
 
 // 树测试
 void test_tree_insrt() {
@@ -47,9 +56,472 @@ void test_tree_delete() {
     std::cout << std::endl;
 }
 
+// 排名/选择/区间统计: 与std::set对照
+void test_tree_order_stat() {
+    my_tree::AVLTree<long, my_tree::AVLSumAug<long>> tree;
+    std::set<long> ref;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 50000; i++) {
+        long value = rng() % 20000;
+        if (rng() % 3) {
+            tree.root = tree.insert_node(tree.root, value);
+            ref.insert(value);
+        } else {
+            tree.root = tree.delete_node(tree.root, value);
+            ref.erase(value);
+        }
+    }
+    std::vector<long> sorted(ref.begin(), ref.end());
+    bool ok = tree.size() == (int)sorted.size();
+    for (int i = 0; i < 2000; i++) {
+        long lo = rng() % 21000 - 500;
+        long hi = lo + rng() % 3000;
+        auto first = std::lower_bound(sorted.begin(), sorted.end(), lo);
+        auto last = std::upper_bound(sorted.begin(), sorted.end(), hi);
+        long sum = 0;
+        for (auto it = first; it != last; ++it) {
+            sum += *it;
+        }
+        ok = ok && tree.rank(lo) == first - sorted.begin();
+        ok = ok && tree.count_in_range(lo, hi) == last - first;
+        ok = ok && tree.aggregate_range(lo, hi) == sum;
+        int k = rng() % sorted.size();
+        long value = -1;
+        ok = ok && tree.select(k, value) && value == sorted[k];
+    }
+    long p99 = 0;
+    tree.select(tree.size() * 99 / 100, p99);
+    std::cout << "size:" << tree.size() << " height:" << tree.get_height(tree.root) << " p99:" << p99
+              << " same as std::set:" << ok << std::endl;
+}
+
+// 校验AVL性质与子树大小，返回子树高度，不满足返回-1
+template <typename Node>
+int check_avl(Node *node) {
+    if (node == nullptr)
+        return 0;
+    int left = check_avl(node->left);
+    int right = check_avl(node->right);
+    int left_size = node->left ? node->left->size : 0;
+    int right_size = node->right ? node->right->size : 0;
+    if (left < 0 || right < 0 || std::abs(left - right) > 1 || node->size != left_size + right_size + 1)
+        return -1;
+    if (node->height != std::max(left, right) + 1)
+        return -1;
+    return node->height;
+}
+
+template <typename Tree>
+std::vector<long> tree_values(Tree &tree) {
+    std::vector<long> values;
+    long value;
+    for (int i = 0; i < tree.size(); i++) {
+        tree.select(i, value);
+        values.push_back(value);
+    }
+    return values;
+}
+
+// 随机有序无重复序列
+std::vector<long> random_sorted(std::mt19937 &rng, int num, long range) {
+    std::set<long> values;
+    while ((int)values.size() < num) {
+        values.insert(rng() % range);
+    }
+    return std::vector<long>(values.begin(), values.end());
+}
+
+// 有序构建与并/交/差: 与std::set_*对照
+void test_tree_bulk() {
+    std::mt19937 rng(7);
+    bool ok = true;
+    for (int round = 0; round < 20; round++) {
+        int num_a = rng() % 20000;
+        int num_b = rng() % 20000;
+        std::vector<long> a = random_sorted(rng, num_a, 40000);
+        std::vector<long> b = random_sorted(rng, num_b, 40000);
+        for (int op = 0; op < 4; op++) {
+            my_tree::AVLTree<long, my_tree::AVLSumAug<long>> tree_a, tree_b;
+            tree_a.build_from_sorted(a.begin(), a.end());
+            tree_b.build_from_sorted(b.begin(), b.end());
+            std::vector<long> expect;
+            if (op == 0) {
+                tree_a.union_with(tree_b);
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+            } else if (op == 1) {
+                tree_a.intersect_with(tree_b);
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+            } else if (op == 2) {
+                tree_a.difference_with(tree_b);
+                std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+            } else {
+                tree_a.insert_range(b.begin(), b.end());
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+            }
+            long sum = 0;
+            for (long v : expect) {
+                sum += v;
+            }
+            ok = ok && (op == 3 || tree_b.root == nullptr) && check_avl(tree_a.root) >= 0;
+            ok = ok && tree_values(tree_a) == expect;
+            ok = ok && (expect.empty() || tree_a.aggregate_range(expect.front(), expect.back()) == sum);
+        }
+    }
+    // 批量中有重复key时只插入一次
+    my_tree::AVLTree<long> dup_tree;
+    std::vector<long> dup_keys = {1, 3, 3, 3, 5, 7, 7};
+    dup_tree.insert_range(dup_keys.begin(), dup_keys.end());
+    dup_tree.insert_range(dup_keys.begin(), dup_keys.end());
+    ok = ok && tree_values(dup_tree) == std::vector<long>{1, 3, 5, 7} && check_avl(dup_tree.root) >= 0;
+    std::cout << "build/union/intersect/difference/insert_range same as std::set_*: " << ok << std::endl;
+}
+
+// 有序批量更新耗时: 逐个插入 vs build_from_sorted/insert_range
+void test_tree_bulk_bench() {
+    const int num = 1000000;
+    const int batch = 100000;
+    std::vector<int> keys(num);
+    for (int i = 0; i < num; i++) {
+        keys[i] = i * 2;
+    }
+    std::vector<int> updates(batch);
+    for (int i = 0; i < batch; i++) {
+        updates[i] = (int)((long)i * num * 2 / batch) + 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    my_tree::AVLTree<int> tree_insert;
+    for (int key : keys) {
+        tree_insert.root = tree_insert.insert_node(tree_insert.root, key);
+    }
+    double insert_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int key : updates) {
+        tree_insert.root = tree_insert.insert_node(tree_insert.root, key);
+    }
+    double batch_insert_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    my_tree::AVLTree<int> tree_build;
+    tree_build.build_from_sorted(keys.begin(), keys.end());
+    double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    tree_build.insert_range(updates.begin(), updates.end());
+    double batch_range_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "build " << num << " keys(ms), insert_node:" << insert_ms << " build_from_sorted:" << build_ms
+              << std::endl;
+    std::cout << "apply sorted batch " << batch << "(ms), insert_node:" << batch_insert_ms
+              << " insert_range:" << batch_range_ms << " size:" << tree_build.size() << std::endl;
+}
+
+// 持久化: 旧快照不受后续修改影响，读者并发取快照校验一致性
+void test_persistent_tree() {
+    my_tree::PersistentAVLTree<int> tree;
+    for (int i = 0; i < 1000; i++) {
+        tree.insert_node(i);
+    }
+    auto old_snap = tree.snapshot();
+    for (int i = 0; i < 1000; i += 2) {
+        tree.delete_node(i);
+    }
+    tree.insert_node(5000);
+    auto new_snap = tree.snapshot();
+    std::cout << "old size:" << old_snap.size() << " find 0:" << old_snap.find_node(0)
+              << " new size:" << new_snap.size() << " find 0:" << new_snap.find_node(0)
+              << " find 5000:" << new_snap.find_node(5000) << std::endl;
+
+    my_tree::PersistentAVLTree<int> random_tree;
+    std::set<int> ref;
+    std::mt19937 rng(3);
+    bool same = true;
+    for (int i = 0; i < 50000; i++) {
+        int value = rng() % 5000;
+        if (rng() % 2) {
+            same = same && random_tree.insert_node(value) == ref.insert(value).second;
+        } else {
+            same = same && random_tree.delete_node(value) == (ref.erase(value) == 1);
+        }
+    }
+    std::vector<int> values;
+    random_tree.snapshot().for_each_inorder([&values](int v) { values.push_back(v); });
+    same = same && values.size() == ref.size() && std::equal(values.begin(), values.end(), ref.begin());
+    std::cout << "random size:" << random_tree.snapshot().size() << " height:" << random_tree.snapshot().height()
+              << " same as std::set:" << same << std::endl;
+
+    // 写者按升序插入，任一快照的内容必须恰好是[0, size)
+    const int num = 20000;
+    my_tree::PersistentAVLTree<int> shared_tree;
+    std::atomic<bool> done{false};
+    std::atomic<long> wrong{0};
+    std::atomic<long> snaps{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto snap = shared_tree.snapshot();
+                int expect = 0;
+                snap.for_each_inorder([&](int v) {
+                    if (v != expect++)
+                        wrong++;
+                });
+                if (expect != snap.size())
+                    wrong++;
+                snaps++;
+            }
+        });
+    }
+    for (int i = 0; i < num; i++) {
+        shared_tree.insert_node(i);
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    std::cout << "size:" << shared_tree.snapshot().size() << " height:" << shared_tree.snapshot().height()
+              << " snapshots:" << snaps << " wrong:" << wrong << std::endl;
+
+    // 快照耗时: 整树复制 vs 取原子根
+    ref.clear();
+    for (int i = 0; i < num; i++) {
+        ref.insert(i);
+    }
+    const int rounds = 200;
+    auto start = std::chrono::steady_clock::now();
+    long sink = 0;
+    for (int i = 0; i < rounds; i++) {
+        std::set<int> copy(ref);
+        sink += copy.size();
+    }
+    double copy_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        sink += shared_tree.snapshot().size();
+    }
+    double snap_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "snapshot of " << num << " keys(us), copy:" << copy_us / rounds << " persistent:" << snap_us / rounds
+              << " sink:" << sink << std::endl;
+}
+
+// 平铺只读树: buffer与mmap文件查询结果与AVLTree一致，并对比查找耗时
+void test_flat_tree() {
+    const int num = 1000000;
+    std::vector<int> keys(num);
+    for (int i = 0; i < num; i++) {
+        keys[i] = i * 3;
+    }
+    my_tree::AVLTree<int> tree;
+    tree.build_from_sorted(keys.begin(), keys.end());
+
+    std::vector<char> buffer;
+    tree.freeze(buffer);
+    my_tree::EytzingerView<int> view;
+    bool ok = view.open(buffer.data(), buffer.size());
+    tree.freeze("flat_tree.bin");
+    my_tree::FlatTreeFile<int> file;
+    ok = file.open("flat_tree.bin") && ok;
+    std::remove("flat_tree.bin"); // 已映射的区域在munmap前仍然有效
+
+    // 构造的count使(count+1)*sizeof(T)溢出回0，或文件被截断，都必须拒绝
+    std::vector<char> bad(buffer);
+    my_tree::FlatTreeHeader header;
+    std::memcpy(&header, bad.data(), sizeof(header));
+    header.count = (1ull << 62) - 1;
+    std::memcpy(bad.data(), &header, sizeof(header));
+    my_tree::EytzingerView<int> bad_view;
+    ok = ok && !bad_view.open(bad.data(), bad.size()) && !bad_view.open(buffer.data(), buffer.size() - 1);
+
+    std::mt19937 rng(5);
+    std::vector<int> probes(num);
+    for (int &probe : probes) {
+        probe = rng() % (num * 3 + 10) - 5;
+    }
+    for (int i = 0; i < 100000; i++) {
+        int probe = probes[i];
+        bool expect = tree.find_node(tree.root, probe) != nullptr;
+        const int *lower = view.lower_bound(probe);
+        int expect_lower = probe <= 0 ? 0 : (probe + 2) / 3 * 3;
+        ok = ok && view.find_node(probe) == expect && file.view().find_node(probe) == expect;
+        ok = ok && (expect_lower < num * 3 ? lower != nullptr && *lower == expect_lower : lower == nullptr);
+    }
+
+    long sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int probe : probes) {
+        sink += tree.find_node(tree.root, probe) != nullptr;
+    }
+    double avl_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int probe : probes) {
+        sink += file.view().find_node(probe);
+    }
+    double flat_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "flat size:" << file.view().size() << " bytes:" << buffer.size() << " same as AVLTree:" << ok
+              << std::endl;
+    std::cout << "find " << num << " keys(ms), AVLTree:" << avl_ms << " mmap Eytzinger:" << flat_ms
+              << " sink:" << sink << std::endl;
+}
+
+// 区间树: 与线性扫描对照
+void test_interval_tree() {
+    using interval_type = my_tree::Interval<int, int>;
+    std::mt19937 rng(11);
+    std::vector<interval_type> intervals;
+    for (int i = 0; i < 100000; i++) {
+        int lo = rng() % 1000000;
+        intervals.push_back({lo, lo + (int)(rng() % 2000), i});
+    }
+    std::vector<interval_type> sorted(intervals);
+    std::sort(sorted.begin(), sorted.end());
+    my_tree::IntervalTree<int> tree;
+    tree.build_from_sorted(sorted.begin(), sorted.end());
+
+    // 随机插删后再对照
+    my_tree::IntervalTree<int> dynamic_tree;
+    std::vector<interval_type> live;
+    for (int i = 0; i < 20000; i++) {
+        dynamic_tree.insert(intervals[i].lo, intervals[i].hi, intervals[i].value);
+    }
+    for (int i = 0; i < 20000; i++) {
+        if (i % 3 == 0) {
+            dynamic_tree.remove(intervals[i].lo, intervals[i].hi, intervals[i].value);
+        } else {
+            live.push_back(intervals[i]);
+        }
+    }
+
+    bool ok = dynamic_tree.size() == (int)live.size();
+    std::vector<int> points;
+    std::vector<std::pair<int, int>> ranges;
+    for (int i = 0; i < 1000; i++) {
+        points.push_back(rng() % 1002000);
+        int a = rng() % 1002000;
+        ranges.push_back({a, a + (int)(rng() % 5000)});
+    }
+    std::vector<std::vector<interval_type>> stab_out, overlap_out;
+    tree.stab_many(points, stab_out);
+    tree.overlap_many(ranges, overlap_out);
+    for (size_t i = 0; i < points.size(); i++) {
+        std::vector<int> expect, got, dynamic_expect, dynamic_got;
+        for (auto &interval : intervals) {
+            if (interval.lo <= points[i] && points[i] <= interval.hi)
+                expect.push_back(interval.value);
+        }
+        for (auto &interval : live) {
+            if (interval.lo <= ranges[i].second && ranges[i].first <= interval.hi)
+                dynamic_expect.push_back(interval.value);
+        }
+        tree.stab(points[i], [&got](const interval_type &interval) { got.push_back(interval.value); });
+        dynamic_tree.overlap(ranges[i].first, ranges[i].second,
+                             [&dynamic_got](const interval_type &interval) { dynamic_got.push_back(interval.value); });
+        std::vector<int> batch_got, overlap_expect, overlap_got;
+        for (auto &interval : stab_out[i]) {
+            batch_got.push_back(interval.value);
+        }
+        for (auto &interval : intervals) {
+            if (interval.lo <= ranges[i].second && ranges[i].first <= interval.hi)
+                overlap_expect.push_back(interval.value);
+        }
+        for (auto &interval : overlap_out[i]) {
+            overlap_got.push_back(interval.value);
+        }
+        for (auto *values : {&expect, &got, &dynamic_expect, &dynamic_got, &batch_got, &overlap_expect, &overlap_got}) {
+            std::sort(values->begin(), values->end());
+        }
+        ok = ok && got == expect && batch_got == expect;
+        ok = ok && dynamic_got == dynamic_expect && overlap_got == overlap_expect;
+    }
+
+    // 耗时对比: 线性扫描 vs 区间树批量点查询
+    long sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int point : points) {
+        for (auto &interval : intervals) {
+            sink += interval.lo <= point && point <= interval.hi;
+        }
+    }
+    double scan_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    tree.stab_many(points, stab_out);
+    for (auto &result : stab_out) {
+        sink += result.size();
+    }
+    double tree_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "intervals:" << tree.size() << " height:" << tree.height() << " same as linear scan:" << ok
+              << std::endl;
+    std::cout << "stab " << points.size() << " points(ms), linear scan:" << scan_ms << " stab_many:" << tree_ms
+              << " sink:" << sink << std::endl;
+}
+
+// arena版: 与std::set对照随机插入删除
+void test_arena_tree() {
+    my_tree::AVLArenaTree<int> arena_tree;
+    std::set<int> ref;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 100000; i++) {
+        int value = rng() % 50000;
+        if (rng() % 3) {
+            arena_tree.insert_node(value);
+            ref.insert(value);
+        } else {
+            arena_tree.delete_node(value);
+            ref.erase(value);
+        }
+    }
+    std::vector<int> values;
+    arena_tree.for_each_inorder([&values](int v) { values.push_back(v); });
+    bool same = values.size() == ref.size() && std::equal(values.begin(), values.end(), ref.begin());
+    std::cout << "size:" << arena_tree.size() << " height:" << arena_tree.height() << " same as std::set:" << same
+              << std::endl;
+    std::cout << "node bytes, pointer:" << sizeof(my_tree::AVLNode<int>)
+              << " arena:" << sizeof(my_tree::AVLArenaNode<int>) << std::endl;
+}
+
+// 插入/删除耗时对比
+void test_arena_tree_bench() {
+    const int num = 300000;
+    std::vector<int> keys(num);
+    for (int i = 0; i < num; i++) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+
+    auto start = std::chrono::steady_clock::now();
+    my_tree::AVLTree<int> avl_tree;
+    for (int key : keys) {
+        avl_tree.root = avl_tree.insert_node(avl_tree.root, key);
+    }
+    for (int key : keys) {
+        avl_tree.root = avl_tree.delete_node(avl_tree.root, key);
+    }
+    double avl_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    my_tree::AVLArenaTree<int> arena_tree;
+    for (int key : keys) {
+        arena_tree.insert_node(key);
+    }
+    for (int key : keys) {
+        arena_tree.delete_node(key);
+    }
+    arena_tree.release();
+    double arena_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "insert+delete " << num << " keys(ms), AVLTree:" << avl_ms << " AVLArenaTree:" << arena_ms
+              << std::endl;
+}
+
 // 测试函数入口
 int main(int argc, char *argv[]) {
     test_tree_insrt();
     test_tree_delete();
+    test_tree_order_stat();
+    test_tree_bulk();
+    test_tree_bulk_bench();
+    test_persistent_tree();
+    test_flat_tree();
+    test_interval_tree();
+    test_arena_tree();
+    test_arena_tree_bench();
     return 0;
 }
\ No newline at end of file